@@ -5,6 +5,7 @@
 #include "Blueprint/UserWidget.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
 #include "CommonUIExtensions.h"
+#include "CommonWidgetPreloadSubsystem.h"
 #include "Engine/AssetManager.h"
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
@@ -46,6 +47,16 @@ UAsyncAction_CreateWidgetAsync* UAsyncAction_CreateWidgetAsync::CreateWidgetAsyn
 
 void UAsyncAction_CreateWidgetAsync::Activate()
 {
+	RequestTime = FPlatformTime::Seconds();
+
+	if (UserWidgetSoftClass.Get())
+	{
+		bWasLoaded = true;
+		bSuspendInputUntilComplete = false;
+		OnWidgetLoaded();
+		return;
+	}
+
 	SuspendInputToken = bSuspendInputUntilComplete ? UCommonUIExtensions::SuspendInputForPlayer(OwningPlayer.Get(), InputFilterReason_Template) : NAME_None;
 
 	TWeakObjectPtr<UAsyncAction_CreateWidgetAsync> LocalWeakThis(this);
@@ -87,6 +98,11 @@ void UAsyncAction_CreateWidgetAsync::OnWidgetLoaded()
 	if (UserWidgetClass)
 	{
 		UUserWidget* UserWidget = UWidgetBlueprintLibrary::Create(World.Get(), UserWidgetClass, OwningPlayer.Get());
+		if (UCommonWidgetPreloadSubsystem* PreloadSubsystem = UGameInstance::GetSubsystem<UCommonWidgetPreloadSubsystem>(GameInstance.Get()))
+		{
+			PreloadSubsystem->MarkWidgetClassUsed(UserWidgetSoftClass.ToSoftObjectPath());
+			PreloadSubsystem->RecordLoadToDisplay(RequestTime, bWasLoaded);
+		}
 		OnComplete.Broadcast(UserWidget);
 	}
 
@@ -11,7 +11,6 @@
 #include "Materials/Material.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Rendering/SlateRenderer.h"
-#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(CommonPlayerInputKey)
 
@@ -122,6 +121,11 @@ void UCommonPlayerInputKey::NativeConstruct()
 
 void UCommonPlayerInputKey::NativeDestruct()
 {
+	if (UCommonUITickerSubsystem* Ticker = HoldProgressTickHandle.IsValid() ? UCommonUITickerSubsystem::Get(this) : nullptr)
+	{
+		Ticker->RemoveTicker(HoldProgressTickHandle);
+	}
+
 	if (ProgressPercentageMID)
 	{
 		// Need to restore the material on the brush before we kill off the MID.
@@ -225,7 +229,14 @@ void UCommonPlayerInputKey::StartHoldProgress(FName HoldActionName, float HoldDu
 		HoldKeybindDuration = HoldDuration;
 		HoldKeybindStartTime = GetWorld()->GetRealTimeSeconds();
 
-		UpdateHoldProgress();
+		if (UpdateHoldProgress())
+		{
+			// Keep updating the hold progress every frame until it completes or stops.
+			if (UCommonUITickerSubsystem* Ticker = UCommonUITickerSubsystem::Get(this))
+			{
+				HoldProgressTickHandle = Ticker->AddTicker(this, FCommonUITickDelegate::CreateUObject(this, &ThisClass::HandleHoldProgressTick), HoldProgressTickHandle);
+			}
+		}
 	}
 }
 
@@ -236,6 +247,11 @@ void UCommonPlayerInputKey::StopHoldProgress(FName HoldActionName, bool bComplet
 		HoldKeybindStartTime = 0.f;
 		HoldKeybindDuration = 0.f;
 
+		if (UCommonUITickerSubsystem* Ticker = HoldProgressTickHandle.IsValid() ? UCommonUITickerSubsystem::Get(this) : nullptr)
+		{
+			Ticker->RemoveTicker(HoldProgressTickHandle);
+		}
+
 		if (ensure(ProgressPercentageMID))
 		{
 			ProgressPercentageMID->SetScalarParameterValue(PercentageMaterialParameterName, 0.f);
@@ -259,8 +275,10 @@ void UCommonPlayerInputKey::SyncHoldProgress()
 	}
 }
 
-void UCommonPlayerInputKey::UpdateHoldProgress()
+bool UCommonPlayerInputKey::UpdateHoldProgress()
 {
+	bool bInProgress = false;
+
 	if (HoldKeybindStartTime != 0.f && HoldKeybindDuration > 0.f)
 	{
 		const float CurrentTime = GetWorld()->GetRealTimeSeconds();
@@ -272,8 +290,7 @@ void UCommonPlayerInputKey::UpdateHoldProgress()
 			const float HoldKeybindPercentage = ElapsedTime / HoldKeybindDuration;
 			ProgressPercentageMID->SetScalarParameterValue(PercentageMaterialParameterName, HoldKeybindPercentage);
 
-			// Schedule a callback for next tick to update the hold progress again.
-			GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ThisClass::UpdateHoldProgress);		
+			bInProgress = true;
 		}
 
 		if (bShowTimeCountDown)
@@ -288,6 +305,13 @@ void UCommonPlayerInputKey::UpdateHoldProgress()
 			RecalculateDesiredSize();
 		}
 	}
+
+	return bInProgress;
+}
+
+bool UCommonPlayerInputKey::HandleHoldProgressTick(float DeltaTime)
+{
+	return UpdateHoldProgress();
 }
 
 void UCommonPlayerInputKey::UpdateKeybindWidget()
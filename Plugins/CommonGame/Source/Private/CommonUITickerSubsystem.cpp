@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CommonUITickerSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Misc/App.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(CommonUITickerSubsystem)
+
+UCommonUITickerSubsystem* UCommonUITickerSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return UGameInstance::GetSubsystem<UCommonUITickerSubsystem>(World->GetGameInstance());
+	}
+	return nullptr;
+}
+
+bool UCommonUITickerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !CastChecked<UGameInstance>(Outer)->IsDedicatedServerInstance();
+}
+
+void UCommonUITickerSubsystem::Deinitialize()
+{
+	Entries.Reset();
+	PendingEntries.Reset();
+
+	Super::Deinitialize();
+}
+
+FCommonUITickHandle UCommonUITickerSubsystem::AddTicker(const UObject* Owner, FCommonUITickDelegate Delegate, FCommonUITickHandle ExistingHandle)
+{
+	if (IsTicking(ExistingHandle))
+	{
+		return ExistingHandle;
+	}
+
+	FCommonUITickHandle Handle;
+	if (Owner && Delegate.IsBound())
+	{
+		FEntry& Entry = bIsTicking ? PendingEntries.AddDefaulted_GetRef() : Entries.AddDefaulted_GetRef();
+		Entry.Owner = Owner;
+		Entry.Delegate = MoveTemp(Delegate);
+		Entry.Id = NextId++;
+		// Zero is the invalid handle.
+		if (NextId == 0)
+		{
+			NextId = 1;
+		}
+		Handle.Id = Entry.Id;
+	}
+	return Handle;
+}
+
+void UCommonUITickerSubsystem::RemoveTicker(FCommonUITickHandle& Handle)
+{
+	if (const FEntry* Entry = FindEntry(Handle.Id))
+	{
+		// Removed entries are compacted away after the next tick, so removing never moves or destroys an entry that is being run.
+		const_cast<FEntry*>(Entry)->bRemoved = true;
+	}
+	Handle.Reset();
+}
+
+bool UCommonUITickerSubsystem::IsTicking(const FCommonUITickHandle& Handle) const
+{
+	return FindEntry(Handle.Id) != nullptr;
+}
+
+void UCommonUITickerSubsystem::Tick(float DeltaTime)
+{
+	// UI animations keep their pace under time dilation and pause.
+	const float UndilatedDeltaTime = FApp::GetDeltaTime();
+
+	bIsTicking = true;
+	for (FEntry& Entry : Entries)
+	{
+		if (!Entry.bRemoved && (!Entry.Owner.IsValid() || !Entry.Delegate.IsBound() || !Entry.Delegate.Execute(UndilatedDeltaTime)))
+		{
+			Entry.bRemoved = true;
+		}
+	}
+	bIsTicking = false;
+
+	Entries.RemoveAllSwap([](const FEntry& Entry) { return Entry.bRemoved; }, EAllowShrinking::No);
+	if (PendingEntries.Num() > 0)
+	{
+		Entries.Append(MoveTemp(PendingEntries));
+		PendingEntries.Reset();
+	}
+}
+
+ETickableTickType UCommonUITickerSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UCommonUITickerSubsystem::IsTickable() const
+{
+	return Entries.Num() > 0 || PendingEntries.Num() > 0;
+}
+
+UWorld* UCommonUITickerSubsystem::GetTickableGameObjectWorld() const
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+	return GameInstance ? GameInstance->GetWorld() : nullptr;
+}
+
+TStatId UCommonUITickerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCommonUITickerSubsystem, STATGROUP_Tickables);
+}
+
+const UCommonUITickerSubsystem::FEntry* UCommonUITickerSubsystem::FindEntry(uint32 Id) const
+{
+	if (Id == 0)
+	{
+		return nullptr;
+	}
+
+	auto MatchesId = [Id](const FEntry& Entry) { return Entry.Id == Id && !Entry.bRemoved; };
+	if (const FEntry* Entry = Entries.FindByPredicate(MatchesId))
+	{
+		return Entry;
+	}
+	return PendingEntries.FindByPredicate(MatchesId);
+}
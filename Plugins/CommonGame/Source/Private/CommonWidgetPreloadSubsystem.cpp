@@ -0,0 +1,253 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CommonWidgetPreloadSubsystem.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetBlueprintGeneratedClass.h"
+#include "Blueprint/WidgetTree.h"
+#include "CommonGameStats.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "LogCommonGame.h"
+#include "Misc/App.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(CommonWidgetPreloadSubsystem)
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Widget Load To Display (ms)"), STAT_CommonWidgetLoadToDisplay, STATGROUP_CommonGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widget Requests Already Loaded"), STAT_CommonWidgetRequestsLoaded, STATGROUP_CommonGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widget Requests Loading"), STAT_CommonWidgetRequestsLoading, STATGROUP_CommonGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Preloaded Widget Classes"), STAT_CommonPreloadedWidgetClasses, STATGROUP_CommonGame);
+DECLARE_MEMORY_STAT(TEXT("Preloaded Widget Memory (Estimate)"), STAT_CommonPreloadedWidgetMemory, STATGROUP_CommonGame);
+
+static FAutoConsoleCommandWithWorld CmdCommonWidgetPreloadDump(
+	TEXT("CommonGame.WidgetPreload.Dump"),
+	TEXT("Logs the preloaded widget classes, their estimated memory, and load-to-display latency so far."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UCommonWidgetPreloadSubsystem* PreloadSubsystem = UCommonWidgetPreloadSubsystem::Get(World))
+		{
+			PreloadSubsystem->DumpToLog();
+		}
+	}));
+
+namespace CommonWidgetPreload
+{
+	/** Rough footprint of a widget class: the class, its default object and its widget tree template. Referenced assets aren't counted. */
+	static int64 EstimateClassSize(UClass* WidgetClass)
+	{
+		FResourceSizeEx ResourceSize(EResourceSizeMode::EstimatedTotal);
+		WidgetClass->GetResourceSizeEx(ResourceSize);
+		if (UObject* DefaultObject = WidgetClass->GetDefaultObject(false))
+		{
+			DefaultObject->GetResourceSizeEx(ResourceSize);
+		}
+		if (const UWidgetBlueprintGeneratedClass* WidgetBlueprintClass = Cast<UWidgetBlueprintGeneratedClass>(WidgetClass))
+		{
+			if (UWidgetTree* WidgetTree = WidgetBlueprintClass->GetWidgetTreeArchetype())
+			{
+				WidgetTree->GetResourceSizeEx(ResourceSize);
+			}
+		}
+		return ResourceSize.GetTotalMemoryBytes();
+	}
+}
+
+UCommonWidgetPreloadSubsystem* UCommonWidgetPreloadSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return UGameInstance::GetSubsystem<UCommonWidgetPreloadSubsystem>(World->GetGameInstance());
+	}
+	return nullptr;
+}
+
+bool UCommonWidgetPreloadSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !CastChecked<UGameInstance>(Outer)->IsDedicatedServerInstance();
+}
+
+void UCommonWidgetPreloadSubsystem::Deinitialize()
+{
+	if (InFlightHandle.IsValid())
+	{
+		InFlightHandle->CancelHandle();
+		InFlightHandle.Reset();
+	}
+	for (const TPair<FSoftObjectPath, FPreloadedClass>& Pair : Preloaded)
+	{
+		Pair.Value.Handle->ReleaseHandle();
+	}
+	Preloaded.Reset();
+	PendingPreloads.Reset();
+	PreloadedBytes = 0;
+	SET_DWORD_STAT(STAT_CommonPreloadedWidgetClasses, 0);
+	SET_MEMORY_STAT(STAT_CommonPreloadedWidgetMemory, 0);
+
+	Super::Deinitialize();
+}
+
+void UCommonWidgetPreloadSubsystem::DeclareLikelyWidgets(const TArray<TSoftClassPtr<UUserWidget>>& WidgetClasses)
+{
+	for (const TSoftClassPtr<UUserWidget>& WidgetClass : WidgetClasses)
+	{
+		DeclareLikelyWidget(WidgetClass.ToSoftObjectPath());
+	}
+}
+
+void UCommonWidgetPreloadSubsystem::DeclareLikelyWidget(const FSoftObjectPath& WidgetClassPath)
+{
+	if (WidgetClassPath.IsNull() || WidgetClassPath == InFlightPath)
+	{
+		return;
+	}
+
+	if (FPreloadedClass* PreloadedClass = Preloaded.Find(WidgetClassPath))
+	{
+		PreloadedClass->LastUseTime = FPlatformTime::Seconds();
+		return;
+	}
+	PendingPreloads.AddUnique(WidgetClassPath);
+}
+
+void UCommonWidgetPreloadSubsystem::MarkWidgetClassUsed(const FSoftObjectPath& WidgetClassPath)
+{
+	if (FPreloadedClass* PreloadedClass = Preloaded.Find(WidgetClassPath))
+	{
+		PreloadedClass->LastUseTime = FPlatformTime::Seconds();
+	}
+}
+
+void UCommonWidgetPreloadSubsystem::RecordLoadToDisplay(double RequestTime, bool bWasLoaded)
+{
+	const double LoadToDisplayMs = (FPlatformTime::Seconds() - RequestTime) * 1000.0;
+	SET_FLOAT_STAT(STAT_CommonWidgetLoadToDisplay, LoadToDisplayMs);
+	if (bWasLoaded)
+	{
+		INC_DWORD_STAT(STAT_CommonWidgetRequestsLoaded);
+		++NumRequestsLoaded;
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_CommonWidgetRequestsLoading);
+	}
+
+	++NumRequests;
+	TotalLoadToDisplayMs += LoadToDisplayMs;
+	MaxLoadToDisplayMs = FMath::Max(MaxLoadToDisplayMs, LoadToDisplayMs);
+}
+
+void UCommonWidgetPreloadSubsystem::DumpToLog() const
+{
+	for (const TPair<FSoftObjectPath, FPreloadedClass>& Pair : Preloaded)
+	{
+		UE_LOG(LogCommonGame, Log, TEXT("WidgetPreload: %s %.1f KB"), *Pair.Key.ToString(), Pair.Value.SizeBytes / 1024.0);
+	}
+	UE_LOG(LogCommonGame, Log, TEXT("WidgetPreload: %d classes, %.2f / %.2f MB, %d pending"), Preloaded.Num(), PreloadedBytes / (1024.0 * 1024.0), MemoryBudgetMB, PendingPreloads.Num());
+	UE_LOG(LogCommonGame, Log, TEXT("WidgetPreload: %d requests, %d already loaded, load to display avg %.2f ms, max %.2f ms"),
+		NumRequests, NumRequestsLoaded, NumRequests > 0 ? TotalLoadToDisplayMs / NumRequests : 0.0, MaxLoadToDisplayMs);
+}
+
+void UCommonWidgetPreloadSubsystem::Tick(float DeltaTime)
+{
+	if (InFlightHandle.IsValid())
+	{
+		if (!InFlightHandle->HasLoadCompleted() && !InFlightHandle->WasCanceled())
+		{
+			return;
+		}
+		HandlePreloadCompleted();
+	}
+
+	// One preload at a time, and only when the frame had time to spare and nothing else is streaming.
+	if (FApp::GetDeltaTime() > IdleFrameTime || IsAsyncLoading())
+	{
+		return;
+	}
+
+	while (PendingPreloads.Num() > 0 && !InFlightHandle.IsValid())
+	{
+		const FSoftObjectPath WidgetClassPath = PendingPreloads[0];
+		PendingPreloads.RemoveAt(0, EAllowShrinking::No);
+		if (!Preloaded.Contains(WidgetClassPath))
+		{
+			InFlightPath = WidgetClassPath;
+			// Below the default, so on-demand loads from CreateWidgetAsync and PushWidgetToLayerStackAsync go first.
+			InFlightHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(WidgetClassPath, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority - 1);
+			if (!InFlightHandle.IsValid())
+			{
+				InFlightPath.Reset();
+			}
+		}
+	}
+}
+
+ETickableTickType UCommonWidgetPreloadSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UCommonWidgetPreloadSubsystem::IsTickable() const
+{
+	return PendingPreloads.Num() > 0 || InFlightHandle.IsValid();
+}
+
+TStatId UCommonWidgetPreloadSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCommonWidgetPreloadSubsystem, STATGROUP_Tickables);
+}
+
+void UCommonWidgetPreloadSubsystem::HandlePreloadCompleted()
+{
+	TSharedPtr<FStreamableHandle> Handle = MoveTemp(InFlightHandle);
+	const FSoftObjectPath WidgetClassPath = InFlightPath;
+	InFlightHandle.Reset();
+	InFlightPath.Reset();
+
+	UClass* WidgetClass = Cast<UClass>(WidgetClassPath.ResolveObject());
+	if (WidgetClass == nullptr || !Handle.IsValid())
+	{
+		UE_LOG(LogCommonGame, Warning, TEXT("WidgetPreload: Failed to preload %s"), *WidgetClassPath.ToString());
+		return;
+	}
+
+	FPreloadedClass& PreloadedClass = Preloaded.Add(WidgetClassPath);
+	PreloadedClass.Handle = Handle;
+	PreloadedClass.SizeBytes = CommonWidgetPreload::EstimateClassSize(WidgetClass);
+	PreloadedClass.LastUseTime = FPlatformTime::Seconds();
+	PreloadedBytes += PreloadedClass.SizeBytes;
+	INC_DWORD_STAT(STAT_CommonPreloadedWidgetClasses);
+
+	EnforceBudget(WidgetClassPath);
+	SET_MEMORY_STAT(STAT_CommonPreloadedWidgetMemory, PreloadedBytes);
+}
+
+void UCommonWidgetPreloadSubsystem::EnforceBudget(const FSoftObjectPath& PathToKeep)
+{
+	const int64 BudgetBytes = static_cast<int64>(MemoryBudgetMB * 1024.0 * 1024.0);
+	while (PreloadedBytes > BudgetBytes)
+	{
+		const FSoftObjectPath* LeastRecentlyUsed = nullptr;
+		double OldestUseTime = TNumericLimits<double>::Max();
+		for (const TPair<FSoftObjectPath, FPreloadedClass>& Pair : Preloaded)
+		{
+			if (Pair.Key != PathToKeep && Pair.Value.LastUseTime < OldestUseTime)
+			{
+				LeastRecentlyUsed = &Pair.Key;
+				OldestUseTime = Pair.Value.LastUseTime;
+			}
+		}
+		if (LeastRecentlyUsed == nullptr)
+		{
+			break;
+		}
+
+		const FSoftObjectPath PathToRelease = *LeastRecentlyUsed;
+		FPreloadedClass ReleasedClass;
+		Preloaded.RemoveAndCopyValue(PathToRelease, ReleasedClass);
+		ReleasedClass.Handle->ReleaseHandle();
+		PreloadedBytes -= ReleasedClass.SizeBytes;
+		DEC_DWORD_STAT(STAT_CommonPreloadedWidgetClasses);
+	}
+}
@@ -2,7 +2,10 @@
 
 #include "PrimaryGameLayout.h"
 
+#include "CommonGameStats.h"
+#include "CommonLayerPoolableWidget.h"
 #include "CommonLocalPlayer.h"
+#include "CommonWidgetPreloadSubsystem.h"
 #include "Engine/GameInstance.h"
 #include "GameUIManagerSubsystem.h"
 #include "GameUIPolicy.h"
@@ -12,6 +15,11 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PrimaryGameLayout)
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Layer Widgets"), STAT_CommonPooledLayerWidgets, STATGROUP_CommonGame);
+// Pushes of a poolable class served by an instance the layer had already built, instead of a new CreateWidget.
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Layer Widget Constructions Avoided"), STAT_CommonLayerWidgetConstructionsAvoided, STATGROUP_CommonGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Layer Widgets Past Pool Cap"), STAT_CommonLayerWidgetsPastPoolCap, STATGROUP_CommonGame);
+
 class UObject;
 
 /*static*/ UPrimaryGameLayout* UPrimaryGameLayout::GetPrimaryGameLayoutForPrimaryPlayer(const UObject* WorldContextObject)
@@ -54,6 +62,30 @@ UPrimaryGameLayout::UPrimaryGameLayout(const FObjectInitializer& ObjectInitializ
 {
 }
 
+void UPrimaryGameLayout::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	if (!IsDesignTime() && LikelyWidgetClasses.Num() > 0)
+	{
+		if (UCommonWidgetPreloadSubsystem* PreloadSubsystem = UCommonWidgetPreloadSubsystem::Get(this))
+		{
+			PreloadSubsystem->DeclareLikelyWidgets(LikelyWidgetClasses);
+		}
+	}
+}
+
+void UPrimaryGameLayout::BeginDestroy()
+{
+	for (const TPair<FGameplayTag, FCommonLayerWidgetPool>& PoolPair : WidgetPools)
+	{
+		DEC_DWORD_STAT_BY(STAT_CommonPooledLayerWidgets, PoolPair.Value.Widgets.Num());
+	}
+	WidgetPools.Reset();
+
+	Super::BeginDestroy();
+}
+
 void UPrimaryGameLayout::SetIsDormant(bool InDormant)
 {
 	if (bIsDormant != InDormant)
@@ -126,6 +158,89 @@ void UPrimaryGameLayout::FindAndRemoveWidgetFromLayer(UCommonActivatableWidget*
 	}
 }
 
+void UPrimaryGameLayout::NotifyWidgetClassDisplayed(const FSoftObjectPath& WidgetClassPath, double RequestTime, bool bWasLoaded)
+{
+	if (UCommonWidgetPreloadSubsystem* PreloadSubsystem = UCommonWidgetPreloadSubsystem::Get(this))
+	{
+		PreloadSubsystem->MarkWidgetClassUsed(WidgetClassPath);
+		PreloadSubsystem->RecordLoadToDisplay(RequestTime, bWasLoaded);
+	}
+}
+
+bool UPrimaryGameLayout::IsOverLayerPoolCap(FGameplayTag LayerName, UCommonActivatableWidgetContainerBase& Layer, UClass* ActivatableWidgetClass)
+{
+	if (!ActivatableWidgetClass || !ActivatableWidgetClass->ImplementsInterface(UCommonLayerPoolableWidget::StaticClass()))
+	{
+		return false;
+	}
+
+	FCommonLayerWidgetPool* Pool = WidgetPools.Find(LayerName);
+	if (Pool == nullptr)
+	{
+		if (GetMaxPooledWidgets(ActivatableWidgetClass) > 0)
+		{
+			return false;
+		}
+		INC_DWORD_STAT(STAT_CommonLayerWidgetsPastPoolCap);
+		return true;
+	}
+
+	int32 NumOfClass = 0;
+	for (const TWeakObjectPtr<UCommonActivatableWidget>& WeakWidget : Pool->Widgets)
+	{
+		const UCommonActivatableWidget* PooledWidget = WeakWidget.Get();
+		if (PooledWidget == nullptr || PooledWidget->GetClass() != ActivatableWidgetClass)
+		{
+			continue;
+		}
+
+		// Released back to the container's pool, which hands it out on the next AddWidget.
+		if (!PooledWidget->IsActivated() && !Layer.GetWidgetList().Contains(PooledWidget))
+		{
+			return false;
+		}
+
+		++NumOfClass;
+	}
+
+	if (NumOfClass < GetMaxPooledWidgets(ActivatableWidgetClass))
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_CommonLayerWidgetsPastPoolCap);
+	return true;
+}
+
+void UPrimaryGameLayout::PrepareLayerWidget(FGameplayTag LayerName, UCommonActivatableWidget& Widget)
+{
+	if (!Widget.Implements<UCommonLayerPoolableWidget>())
+	{
+		return;
+	}
+
+	FCommonLayerWidgetPool& Pool = WidgetPools.FindOrAdd(LayerName);
+	if (Pool.Widgets.Contains(&Widget))
+	{
+		ICommonLayerPoolableWidget::Execute_ResetForReuse(&Widget);
+		INC_DWORD_STAT(STAT_CommonLayerWidgetConstructionsAvoided);
+		return;
+	}
+
+	Pool.Widgets.Add(&Widget);
+	INC_DWORD_STAT(STAT_CommonPooledLayerWidgets);
+}
+
+int32 UPrimaryGameLayout::GetMaxPooledWidgets(UClass* ActivatableWidgetClass) const
+{
+	if (const int32* MaxPooledWidgets = MaxPooledWidgetsPerClass.Find(TSoftClassPtr<UCommonActivatableWidget>(ActivatableWidgetClass)))
+	{
+		return *MaxPooledWidgets;
+	}
+
+	return DefaultMaxPooledWidgetsPerClass;
+}
+
 UCommonActivatableWidgetContainerBase* UPrimaryGameLayout::GetLayerWidget(FGameplayTag LayerName)
 {
 	return Layers.FindRef(LayerName);
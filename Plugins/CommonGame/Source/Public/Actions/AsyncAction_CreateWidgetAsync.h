@@ -18,6 +18,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreateWidgetAsyncDelegate, UUserWid
 
 /**
  * Load the widget class asynchronously, the instance the widget after the loading completes, and return it on OnComplete.
+ * If the class is already loaded (e.g. preloaded by UCommonWidgetPreloadSubsystem), the widget is created right away without suspending input.
  */
 UCLASS(BlueprintType)
 class COMMONGAME_API UAsyncAction_CreateWidgetAsync : public UCancellableAsyncAction
@@ -41,6 +42,10 @@ private:
 	
 	void OnWidgetLoaded();
 
+	/** When the widget was requested, for load-to-display latency. */
+	double RequestTime = 0.0;
+	bool bWasLoaded = false;
+
 	FName SuspendInputToken;
 	TWeakObjectPtr<APlayerController> OwningPlayer;
 	TWeakObjectPtr<UWorld> World;
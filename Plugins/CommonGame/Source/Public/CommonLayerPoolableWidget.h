@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "UObject/Interface.h"
+
+#include "CommonLayerPoolableWidget.generated.h"
+
+UINTERFACE(MinimalAPI, BlueprintType)
+class UCommonLayerPoolableWidget : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Opts an activatable widget into managed reuse by UPrimaryGameLayout. Layer containers already hand released instances
+ * out again through their widget pool. For these classes the layout also resets a reused instance before it is pushed,
+ * and caps how many instances per layer the container pool may keep. Pushes past the cap create an instance that is
+ * dropped once it leaves the layer.
+ */
+class COMMONGAME_API ICommonLayerPoolableWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** Called on a pooled instance right before it is pushed again. Clear anything left over from its last use. */
+	UFUNCTION(BlueprintNativeEvent, Category = "Pool")
+	void ResetForReuse();
+	virtual void ResetForReuse_Implementation() {}
+};
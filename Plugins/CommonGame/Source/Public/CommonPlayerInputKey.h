@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "CommonUITickerSubsystem.h"
 #include "CommonUserWidget.h"
 #include "Fonts/SlateFontInfo.h"
 
@@ -202,8 +203,11 @@ private:
 	 */
 	void SyncHoldProgress();
 
-	/** Called for updating the HoldKeybindImage during a hold keybind */
-	void UpdateHoldProgress();
+	/** Called for updating the HoldKeybindImage during a hold keybind. Returns true while the hold is still in progress. */
+	bool UpdateHoldProgress();
+
+	/** Called by the UI ticker every frame while a hold is in progress */
+	bool HandleHoldProgressTick(float DeltaTime);
 
 	/** Called when we want to set up this keybind widget as a hold keybind */
 	void SetupHoldKeybind();
@@ -218,6 +222,9 @@ private:
 	/** How long, in seconds, we will be doing a hold keybind */
 	float HoldKeybindDuration = 0;
 
+	/** Registration with the shared UI ticker while a hold is in progress */
+	FCommonUITickHandle HoldProgressTickHandle;
+
 	bool bDrawProgress = false;
 	bool bDrawBrushForKey = false;
 	bool bDrawCountdownText = false;
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+
+#include "CommonUITickerSubsystem.generated.h"
+
+/** Called once per frame with the undilated delta time. Return false once there is nothing left to animate. */
+DECLARE_DELEGATE_RetVal_OneParam(bool, FCommonUITickDelegate, float /*DeltaTime*/);
+
+/** Identifies one registration with the UI ticker. */
+struct FCommonUITickHandle
+{
+	bool IsValid() const { return Id != 0; }
+	void Reset() { Id = 0; }
+
+private:
+	friend class UCommonUITickerSubsystem;
+	uint32 Id = 0;
+};
+
+/**
+ * One per-frame tick shared by every UI element that animates over time: hold progress, cooldown sweeps, bar lerps.
+ * Entries live in a compact array that is walked once per frame. An entry goes away when its callback returns false,
+ * when its owner is destroyed, or when it is removed. The subsystem doesn't tick at all while it has no entries.
+ */
+UCLASS()
+class COMMONGAME_API UCommonUITickerSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	static UCommonUITickerSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	/** Starts calling the delegate every frame. Does nothing and returns the same handle if it is still ticking. */
+	FCommonUITickHandle AddTicker(const UObject* Owner, FCommonUITickDelegate Delegate, FCommonUITickHandle ExistingHandle = FCommonUITickHandle());
+
+	/** Stops the entry and resets the handle. Safe to call from inside a tick callback. */
+	void RemoveTicker(FCommonUITickHandle& Handle);
+
+	bool IsTicking(const FCommonUITickHandle& Handle) const;
+
+	int32 GetNumTickers() const { return Entries.Num() + PendingEntries.Num(); }
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<const UObject> Owner;
+		FCommonUITickDelegate Delegate;
+		uint32 Id = 0;
+		bool bRemoved = false;
+	};
+
+	const FEntry* FindEntry(uint32 Id) const;
+
+	TArray<FEntry> Entries;
+
+	/** Entries added while ticking. They start on the next frame. */
+	TArray<FEntry> PendingEntries;
+
+	uint32 NextId = 1;
+	bool bIsTicking = false;
+};
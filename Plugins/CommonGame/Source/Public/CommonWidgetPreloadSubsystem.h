@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "UObject/SoftObjectPtr.h"
+
+#include "CommonWidgetPreloadSubsystem.generated.h"
+
+class UUserWidget;
+struct FStreamableHandle;
+
+/**
+ * Keeps widget classes that are likely to be opened next loaded, so opening them doesn't wait on a load.
+ *
+ * Layouts and screens declare the widgets they expect to open next. Declared classes are streamed in one at a time
+ * at low priority, only on frames that have time to spare, and are kept loaded until the memory budget is exceeded,
+ * in which case the least recently used ones are released. CreateWidgetAsync and layer pushes complete in the same
+ * frame when the class is already loaded.
+ */
+UCLASS(config = Game)
+class COMMONGAME_API UCommonWidgetPreloadSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	static UCommonWidgetPreloadSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	/** Queues widget classes to be streamed in during idle frames. Classes that are already preloaded count as used. */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI|Preload")
+	void DeclareLikelyWidgets(const TArray<TSoftClassPtr<UUserWidget>>& WidgetClasses);
+
+	void DeclareLikelyWidget(const FSoftObjectPath& WidgetClassPath);
+
+	/** Called when a widget of the class is opened, to keep it from being released first. */
+	void MarkWidgetClassUsed(const FSoftObjectPath& WidgetClassPath);
+
+	/** Records the time between a widget being requested and being created. */
+	void RecordLoadToDisplay(double RequestTime, bool bWasLoaded);
+
+	bool IsPreloaded(const FSoftObjectPath& WidgetClassPath) const { return Preloaded.Contains(WidgetClassPath); }
+
+	void DumpToLog() const;
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+private:
+	struct FPreloadedClass
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		int64 SizeBytes = 0;
+		double LastUseTime = 0.0;
+	};
+
+	void HandlePreloadCompleted();
+	void EnforceBudget(const FSoftObjectPath& PathToKeep);
+
+	/** Only start a preload on frames shorter than this, in seconds. */
+	UPROPERTY(config)
+	float IdleFrameTime = 1.f / 50.f;
+
+	/** Estimated memory all preloaded widget classes may use, in megabytes. */
+	UPROPERTY(config)
+	float MemoryBudgetMB = 32.f;
+
+	TArray<FSoftObjectPath> PendingPreloads;
+	TMap<FSoftObjectPath, FPreloadedClass> Preloaded;
+	TSharedPtr<FStreamableHandle> InFlightHandle;
+	FSoftObjectPath InFlightPath;
+	int64 PreloadedBytes = 0;
+
+	int32 NumRequests = 0;
+	int32 NumRequestsLoaded = 0;
+	double TotalLoadToDisplayMs = 0.0;
+	double MaxLoadToDisplayMs = 0.0;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CommonActivatableWidget.h"
+#include "CommonLayerPoolableWidget.h"
 #include "CommonMessagingSubsystem.h"
 
 #include "CommonGameDialog.generated.h"
@@ -54,8 +55,11 @@ public:
 };
 
 
+/**
+ * Dialogs are pooled by the layer they are pushed onto, so SetupDialog must fully reinitialize a reused instance.
+ */
 UCLASS(Abstract)
-class COMMONGAME_API UCommonGameDialog : public UCommonActivatableWidget
+class COMMONGAME_API UCommonGameDialog : public UCommonActivatableWidget, public ICommonLayerPoolableWidget
 {
 	GENERATED_BODY()
 	
@@ -18,6 +18,19 @@ class ULocalPlayer;
 class UObject;
 struct FFrame;
 
+/**
+ * Instances of poolable widget classes that one layer's container has created in its own widget pool.
+ * The container keeps them for reuse, this only tracks them so the layout can reset them and cap their number.
+ */
+USTRUCT()
+struct FCommonLayerWidgetPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TWeakObjectPtr<UCommonActivatableWidget>> Widgets;
+};
+
 /**
  * The state of an async load operation for the UI.
  */
@@ -61,12 +74,26 @@ public:
 	{
 		static_assert(TIsDerivedFrom<ActivatableWidgetT, UCommonActivatableWidget>::IsDerived, "Only CommonActivatableWidgets can be used here");
 
+		const double RequestTime = FPlatformTime::Seconds();
+
+		// Already loaded (e.g. preloaded), so push right away instead of waiting a frame for the streamable callback.
+		if (UClass* LoadedWidgetClass = ActivatableWidgetClass.Get())
+		{
+			ActivatableWidgetT* Widget = PushWidgetToLayerStack<ActivatableWidgetT>(LayerName, LoadedWidgetClass, [StateFunc](ActivatableWidgetT& WidgetToInit) {
+				StateFunc(EAsyncWidgetLayerState::Initialize, &WidgetToInit);
+			});
+
+			StateFunc(EAsyncWidgetLayerState::AfterPush, Widget);
+			NotifyWidgetClassDisplayed(ActivatableWidgetClass.ToSoftObjectPath(), RequestTime, true);
+			return nullptr;
+		}
+
 		static FName NAME_PushingWidgetToLayer("PushingWidgetToLayer");
 		const FName SuspendInputToken = bSuspendInputUntilComplete ? UCommonUIExtensions::SuspendInputForPlayer(GetOwningPlayer(), NAME_PushingWidgetToLayer) : NAME_None;
 
 		FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
 		TSharedPtr<FStreamableHandle> StreamingHandle = StreamableManager.RequestAsyncLoad(ActivatableWidgetClass.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(this,
-			[this, LayerName, ActivatableWidgetClass, StateFunc, SuspendInputToken]()
+			[this, LayerName, ActivatableWidgetClass, StateFunc, SuspendInputToken, RequestTime]()
 			{
 				UCommonUIExtensions::ResumeInputForPlayer(GetOwningPlayer(), SuspendInputToken);
 
@@ -75,6 +102,7 @@ public:
 				});
 
 				StateFunc(EAsyncWidgetLayerState::AfterPush, Widget);
+				NotifyWidgetClassDisplayed(ActivatableWidgetClass.ToSoftObjectPath(), RequestTime, false);
 			})
 		);
 
@@ -103,7 +131,22 @@ public:
 
 		if (UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName))
 		{
-			return Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, InitInstanceFunc);
+			// Created outside the container's widget pool, so the instance isn't kept once it leaves the layer.
+			if (IsOverLayerPoolCap(LayerName, *Layer, ActivatableWidgetClass))
+			{
+				ActivatableWidgetT* Widget = CreateWidget<ActivatableWidgetT>(GetOwningPlayer(), ActivatableWidgetClass);
+				if (Widget)
+				{
+					InitInstanceFunc(*Widget);
+					Layer->AddWidgetInstance(*Widget);
+				}
+				return Widget;
+			}
+
+			return Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, [this, LayerName, &InitInstanceFunc](ActivatableWidgetT& WidgetToInit) {
+				PrepareLayerWidget(LayerName, WidgetToInit);
+				InitInstanceFunc(WidgetToInit);
+			});
 		}
 
 		return nullptr;
@@ -115,7 +158,11 @@ public:
 	// Get the layer widget for the given layer tag.
 	UCommonActivatableWidgetContainerBase* GetLayerWidget(FGameplayTag LayerName);
 
+	virtual void BeginDestroy() override;
+
 protected:
+	virtual void NativeOnInitialized() override;
+
 	/** Register a layer that widgets can be pushed onto. */
 	UFUNCTION(BlueprintCallable, Category="Layer")
 	void RegisterLayer(UPARAM(meta = (Categories = "UI.Layer")) FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget);
@@ -123,6 +170,32 @@ protected:
 	virtual void OnIsDormantChanged();
 
 	void OnWidgetStackTransitioning(UCommonActivatableWidgetContainerBase* Widget, bool bIsTransitioning);
+
+	/**
+	 * The layer's container reuses released instances through its own widget pool, but keeps every instance it ever created.
+	 * Returns true for a poolable class that already has its cap of instances in that pool, all of them still on the layer.
+	 */
+	bool IsOverLayerPoolCap(FGameplayTag LayerName, UCommonActivatableWidgetContainerBase& Layer, UClass* ActivatableWidgetClass);
+
+	/** Called on every instance the layer's container hands out. Resets poolable instances it has handed out before. */
+	void PrepareLayerWidget(FGameplayTag LayerName, UCommonActivatableWidget& Widget);
+
+	int32 GetMaxPooledWidgets(UClass* ActivatableWidgetClass) const;
+
+	/** Reports load-to-display latency of a pushed widget to the preload subsystem. */
+	void NotifyWidgetClassDisplayed(const FSoftObjectPath& WidgetClassPath, double RequestTime, bool bWasLoaded);
+
+	/** Widgets likely to be pushed onto this layout's layers. They are preloaded during idle frames. */
+	UPROPERTY(EditDefaultsOnly, Category = "Preload")
+	TArray<TSoftClassPtr<UUserWidget>> LikelyWidgetClasses;
+
+	/** How many instances of a poolable widget class (see ICommonLayerPoolableWidget) each layer's container pool may keep for reuse. */
+	UPROPERTY(EditDefaultsOnly, Category = "Pooling", meta = (ClampMin = 0))
+	int32 DefaultMaxPooledWidgetsPerClass = 1;
+
+	/** Per-class overrides of DefaultMaxPooledWidgetsPerClass. */
+	UPROPERTY(EditDefaultsOnly, Category = "Pooling")
+	TMap<TSoftClassPtr<UCommonActivatableWidget>, int32> MaxPooledWidgetsPerClass;
 	
 private:
 	bool bIsDormant = false;
@@ -134,4 +207,8 @@ private:
 	// The registered layers for the primary layout.
 	UPROPERTY(Transient, meta = (Categories = "UI.Layer"))
 	TMap<FGameplayTag, TObjectPtr<UCommonActivatableWidgetContainerBase>> Layers;
+
+	// Poolable widget instances owned by each layer's container pool.
+	UPROPERTY(Transient)
+	TMap<FGameplayTag, FCommonLayerWidgetPool> WidgetPools;
 };
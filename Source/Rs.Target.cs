@@ -11,5 +11,6 @@ public class RsTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
 		ExtraModuleNames.Add("Rs");
+		ExtraModuleNames.Add("RsUI");
 	}
 }
@@ -3,13 +3,21 @@
 
 #include "RsAIControllerBase.h"
 
+#include "BrainComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
-#include "Kismet/GameplayStatics.h"
 #include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISenseConfig.h"
+#include "Rs/AI/Component/RsBehaviorTreeComponent.h"
+#include "Rs/AI/Subsystem/RsAILODSubsystem.h"
+#include "Rs/AI/Subsystem/RsPlayerPawnSubsystem.h"
+#include "Rs/AI/Subsystem/RsSquadPerceptionSubsystem.h"
 
 ARsAIControllerBase::ARsAIControllerBase()
 {
 	AIPerception = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("AIPerception"));
+
+	// Used by RunBehaviorTree instead of a default behavior tree component, so AI LOD can throttle the tree.
+	BrainComponent = CreateDefaultSubobject<URsBehaviorTreeComponent>(TEXT("BehaviorTreeComponent"));
 }
 
 ETeamAttitude::Type ARsAIControllerBase::GetTeamAttitudeTowards(const AActor& Other) const
@@ -29,15 +37,6 @@ ETeamAttitude::Type ARsAIControllerBase::GetTeamAttitudeTowards(const AActor& Ot
 	return ETeamAttitude::Neutral;
 }
 
-void ARsAIControllerBase::BeginPlay()
-{
-	Super::BeginPlay();
-	if (APlayerController* PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0))
-	{
-		PlayerController->OnPossessedPawnChanged.AddDynamic(this, &ThisClass::HandlePlayerControllingPawnChanged);
-	}
-}
-
 void ARsAIControllerBase::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
@@ -47,12 +46,107 @@ void ARsAIControllerBase::OnPossess(APawn* InPawn)
 		RunBehaviorTree(BehaviorTree);
 		GetBlackboardComponent()->SetValueAsObject(TEXT("SelfActor"), InPawn);
 	}
+
+	if (bUseSquadPerception)
+	{
+		SetSensesEnabled(false);
+	}
+
+	RegisterWithSubsystems();
 }
 
-void ARsAIControllerBase::HandlePlayerControllingPawnChanged(APawn* InOldPawn, APawn* InNewPawn)
+void ARsAIControllerBase::OnUnPossess()
 {
-	if (BehaviorTree && InNewPawn)
+	// Dormancy belongs to the pawn. Resume the brain, so the next possession starts it normally.
+	if (bDormant)
 	{
-		GetBlackboardComponent()->SetValueAsObject(TEXT("PlayerControllingPawn"), InNewPawn);
+		if (BrainComponent)
+		{
+			BrainComponent->ResumeLogic(TEXT("Dormant"));
+		}
+		bDormant = false;
+	}
+	UnregisterFromSubsystems();
+	
+	Super::OnUnPossess();
+}
+
+void ARsAIControllerBase::SetDormant(bool bNewDormant)
+{
+	if (bDormant == bNewDormant || GetPawn() == nullptr)
+	{
+		return;
+	}
+	bDormant = bNewDormant;
+
+	if (bDormant)
+	{
+		UnregisterFromSubsystems();
+		StopMovement();
+		if (BrainComponent)
+		{
+			BrainComponent->PauseLogic(TEXT("Dormant"));
+		}
+		SetSensesEnabled(false);
+	}
+	else
+	{
+		if (BrainComponent)
+		{
+			BrainComponent->ResumeLogic(TEXT("Dormant"));
+		}
+		SetSensesEnabled(!bUseSquadPerception);
+		RegisterWithSubsystems();
+	}
+}
+
+void ARsAIControllerBase::RegisterWithSubsystems()
+{
+	if (BehaviorTree && GetBlackboardComponent())
+	{
+		if (URsPlayerPawnSubsystem* PlayerPawnSubsystem = URsPlayerPawnSubsystem::Get(this))
+		{
+			PlayerPawnSubsystem->RegisterBlackboard(GetBlackboardComponent());
+		}
+	}
+
+	if (bUseSquadPerception)
+	{
+		if (URsSquadPerceptionSubsystem* SquadPerceptionSubsystem = URsSquadPerceptionSubsystem::Get(this))
+		{
+			SquadPerceptionSubsystem->RegisterController(this);
+		}
+	}
+
+	if (URsAILODSubsystem* AILODSubsystem = URsAILODSubsystem::Get(this))
+	{
+		AILODSubsystem->RegisterController(this);
+	}
+}
+
+void ARsAIControllerBase::UnregisterFromSubsystems()
+{
+	if (URsPlayerPawnSubsystem* PlayerPawnSubsystem = URsPlayerPawnSubsystem::Get(this))
+	{
+		PlayerPawnSubsystem->UnregisterBlackboard(GetBlackboardComponent());
+	}
+	if (URsSquadPerceptionSubsystem* SquadPerceptionSubsystem = URsSquadPerceptionSubsystem::Get(this))
+	{
+		SquadPerceptionSubsystem->UnregisterController(this);
+	}
+	if (URsAILODSubsystem* AILODSubsystem = URsAILODSubsystem::Get(this))
+	{
+		AILODSubsystem->UnregisterController(this);
+	}
+}
+
+void ARsAIControllerBase::SetSensesEnabled(bool bEnabled)
+{
+	for (auto It = AIPerception->GetSensesConfigIterator(); It; ++It)
+	{
+		if (const UAISenseConfig* SenseConfig = *It)
+		{
+			AIPerception->SetSenseEnabled(SenseConfig->GetSenseImplementation(), bEnabled);
+		}
 	}
 }
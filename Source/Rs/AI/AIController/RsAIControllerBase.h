@@ -23,14 +23,33 @@ public:
 	// IGenericTeamAgentInterface
 	virtual ETeamAttitude::Type GetTeamAttitudeTowards(const AActor& Other) const override;
 
+	UAIPerceptionComponent* GetAIPerception() const { return AIPerception; }
+	bool IsUsingSquadPerception() const { return bUseSquadPerception; }
+	FName GetSquadName() const { return SquadName; }
+
+	// Dormant controllers keep their pawn, but pause the behavior tree, perception and every AI subsystem registration. Cleared on unpossess.
+	void SetDormant(bool bNewDormant);
+	bool IsDormant() const { return bDormant; }
+
 protected:
-	virtual void BeginPlay() override;
 	virtual void OnPossess(APawn* InPawn) override;
-	
-	UFUNCTION()
-	void HandlePlayerControllingPawnChanged(APawn* OldPawn, APawn* NewPawn);
+	virtual void OnUnPossess() override;
 
 private:
+	void RegisterWithSubsystems();
+	void UnregisterFromSubsystems();
+	void SetSensesEnabled(bool bEnabled);
+
+	bool bDormant = false;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UBehaviorTree> BehaviorTree;
+
+	// Use the shared squad sight checks instead of this controller's own perception senses.
+	UPROPERTY(EditAnywhere, Category = "RS")
+	bool bUseSquadPerception = false;
+
+	// Controllers with the same squad name share sight. If none, the whole team is one squad.
+	UPROPERTY(EditAnywhere, Category = "RS", meta = (EditCondition = "bUseSquadPerception"))
+	FName SquadName;
 };
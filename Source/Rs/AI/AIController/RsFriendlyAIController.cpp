@@ -3,12 +3,6 @@
 
 #include "RsFriendlyAIController.h"
 
-ARsFriendlyAIController::ARsFriendlyAIController()
-{
-	// RsPlayerCharacter want player state to initialize ability system.
-	bWantsPlayerState = true;
-}
-
 void ARsFriendlyAIController::BeginPlay()
 {
 	Super::BeginPlay();
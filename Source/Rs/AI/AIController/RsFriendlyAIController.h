@@ -14,9 +14,6 @@ class RS_API ARsFriendlyAIController : public ARsAIControllerBase
 {
 	GENERATED_BODY()
 
-public:
-	ARsFriendlyAIController();
-
 protected:
 	virtual void BeginPlay() override;
 	virtual void OnPossess(APawn* InPawn) override;
@@ -0,0 +1,30 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsBehaviorTreeComponent.h"
+
+#include "Rs/AI/RsAIStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Behavior Tree Updates Throttled"), STAT_RsBehaviorTreeUpdatesThrottled, STATGROUP_RsAI);
+
+void URsBehaviorTreeComponent::SetMinTickInterval(float InMinTickInterval)
+{
+	MinTickInterval = FMath::Max(InMinTickInterval, 0.f);
+}
+
+void URsBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	if (MinTickInterval > 0.f)
+	{
+		SkippedDeltaTime += DeltaTime;
+		if (SkippedDeltaTime < MinTickInterval)
+		{
+			INC_DWORD_STAT(STAT_RsBehaviorTreeUpdatesThrottled);
+			return;
+		}
+		DeltaTime = SkippedDeltaTime;
+	}
+	SkippedDeltaTime = 0.f;
+	
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
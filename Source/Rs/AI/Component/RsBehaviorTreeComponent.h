@@ -0,0 +1,30 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "RsBehaviorTreeComponent.generated.h"
+
+/**
+ * Behavior tree component with a minimum update interval for AI LOD.
+ * The tree reschedules its own tick interval after every update, so the interval is enforced here instead of through the tick function.
+ */
+UCLASS()
+class RS_API URsBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Updates the tree wants sooner than this are delayed, and run once with the summed delta time. 0 means every update the tree schedules.
+	void SetMinTickInterval(float InMinTickInterval);
+	float GetMinTickInterval() const { return MinTickInterval; }
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	float MinTickInterval = 0.f;
+
+	// Delta time of the delayed updates.
+	float SkippedDeltaTime = 0.f;
+};
@@ -0,0 +1,7 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("RsAI"), STATGROUP_RsAI, STATCAT_Advanced);
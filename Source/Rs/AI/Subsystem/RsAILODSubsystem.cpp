@@ -0,0 +1,248 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsAILODSubsystem.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISenseConfig.h"
+#include "Rs/AI/AIController/RsAIControllerBase.h"
+#include "Rs/AI/Component/RsBehaviorTreeComponent.h"
+#include "Rs/System/RsSignificanceSubsystem.h"
+
+static TAutoConsoleVariable<bool> CVarRsAILODDebug(
+	TEXT("rs.AILOD.Debug"),
+	false,
+	TEXT("Show the number of AI agents in each AI LOD tier on screen."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<bool> CVarRsAILODEnable(
+	TEXT("rs.AILOD.Enable"),
+	true,
+	TEXT("Throttle AI update rates by AI LOD tier. When disabled, every agent uses the first tier."),
+	ECVF_Default);
+
+URsAILODSubsystem* URsAILODSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsAILODSubsystem>();
+	}
+	return nullptr;
+}
+
+void URsAILODSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (Tiers.IsEmpty())
+	{
+		// Full rate, reduced rate, and background.
+		auto AddTier = [this](float MaxDistance, float BehaviorTreeTickInterval, bool bEnablePerception, float MovementTickInterval, float AnimationTickInterval)
+		{
+			FRsAILODTier& Tier = Tiers.AddDefaulted_GetRef();
+			Tier.MaxDistance = MaxDistance;
+			Tier.BehaviorTreeTickInterval = BehaviorTreeTickInterval;
+			Tier.bEnablePerception = bEnablePerception;
+			Tier.MovementTickInterval = MovementTickInterval;
+			Tier.AnimationTickInterval = AnimationTickInterval;
+		};
+		AddTier(2000.f, 0.f, true, 0.f, 0.f);
+		AddTier(5000.f, 0.1f, true, 0.05f, 0.05f);
+		AddTier(0.f, 0.5f, false, 0.2f, 0.25f);
+	}
+}
+
+bool URsAILODSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsAILODSubsystem::RegisterController(ARsAIControllerBase* Controller)
+{
+	if (Controller == nullptr)
+	{
+		return;
+	}
+
+	UnregisterController(Controller);
+	Agents.Add({ Controller, INDEX_NONE });
+}
+
+void URsAILODSubsystem::UnregisterController(ARsAIControllerBase* Controller)
+{
+	const int32 Index = Agents.IndexOfByPredicate([Controller](const FAgent& Agent)
+	{
+		return Agent.Controller == Controller;
+	});
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Restore full rate, since the pawn may be possessed by a player next. (e.g. party switch)
+	if (Controller && Agents[Index].Tier > 0)
+	{
+		ApplyTier(*Controller, Tiers[0]);
+	}
+	Agents.RemoveAtSwap(Index);
+}
+
+int32 URsAILODSubsystem::GetControllerTier(const ARsAIControllerBase* Controller) const
+{
+	const FAgent* Agent = Agents.FindByPredicate([Controller](const FAgent& Agent)
+	{
+		return Agent.Controller == Controller;
+	});
+	return Agent ? Agent->Tier : INDEX_NONE;
+}
+
+void URsAILODSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+
+	const int32 NumEvaluations = FMath::Min(MaxEvaluationsPerFrame, Agents.Num());
+	for (int32 Count = 0; Count < NumEvaluations && !Agents.IsEmpty(); ++Count)
+	{
+		NextEvaluationIndex = NextEvaluationIndex % Agents.Num();
+		FAgent& Agent = Agents[NextEvaluationIndex];
+		
+		ARsAIControllerBase* Controller = Agent.Controller.Get();
+		if (Controller == nullptr)
+		{
+			Agents.RemoveAtSwap(NextEvaluationIndex);
+			continue;
+		}
+		
+		const int32 NewTier = EvaluateTier(*Controller, PlayerLocations);
+		if (NewTier != Agent.Tier)
+		{
+			Agent.Tier = NewTier;
+			ApplyTier(*Controller, Tiers[NewTier]);
+		}
+		++NextEvaluationIndex;
+	}
+
+	if (CVarRsAILODDebug.GetValueOnGameThread())
+	{
+		DrawDebugOverlay();
+	}
+}
+
+bool URsAILODSubsystem::IsTickable() const
+{
+	return !Agents.IsEmpty() && !Tiers.IsEmpty();
+}
+
+TStatId URsAILODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsAILODSubsystem, STATGROUP_Tickables);
+}
+
+int32 URsAILODSubsystem::EvaluateTier(const ARsAIControllerBase& Controller, const TArray<FVector, TInlineAllocator<4>>& PlayerLocations) const
+{
+	const APawn* Pawn = Controller.GetPawn();
+	if (Pawn == nullptr || PlayerLocations.IsEmpty() || !CVarRsAILODEnable.GetValueOnGameThread())
+	{
+		return 0;
+	}
+
+	float MinDistanceSquared = TNumericLimits<float>::Max();
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(PlayerLocation, Pawn->GetActorLocation()));
+	}
+
+	int32 Tier = Tiers.Num() - 1;
+	for (int32 Index = 0; Index < Tiers.Num() - 1; ++Index)
+	{
+		if (MinDistanceSquared <= FMath::Square(Tiers[Index].MaxDistance))
+		{
+			Tier = Index;
+			break;
+		}
+	}
+
+	// Where the significance subsystem runs, it already accounts for visibility and combat.
+	// It only knows the local views though, so with remote players the less aggressive of the two tiers wins.
+	// Nothing is rendered on a dedicated server, so only distance is used there.
+	const URsSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<URsSignificanceSubsystem>();
+	if (const FRsSignificanceTier* SignificanceTier = SignificanceSubsystem ? SignificanceSubsystem->FindTier(Pawn) : nullptr)
+	{
+		const int32 SignificanceAILODTier = FMath::Clamp(SignificanceTier->AILODTier, 0, Tiers.Num() - 1);
+		Tier = GetWorld()->GetNetMode() == NM_Standalone ? SignificanceAILODTier : FMath::Min(Tier, SignificanceAILODTier);
+	}
+	else if (!IsRunningDedicatedServer() && !Pawn->WasRecentlyRendered(0.25f))
+	{
+		Tier = FMath::Min(Tier + NotRenderedTierOffset, Tiers.Num() - 1);
+	}
+	
+	return Tier;
+}
+
+void URsAILODSubsystem::ApplyTier(ARsAIControllerBase& Controller, const FRsAILODTier& Tier) const
+{
+	// The tree overwrites its own tick interval after every update, so the interval is enforced by the component.
+	if (URsBehaviorTreeComponent* BehaviorTreeComponent = Cast<URsBehaviorTreeComponent>(Controller.GetBrainComponent()))
+	{
+		BehaviorTreeComponent->SetMinTickInterval(Tier.BehaviorTreeTickInterval);
+	}
+
+	// Squad perception controllers keep their own senses off at every tier.
+	UAIPerceptionComponent* PerceptionComponent = Controller.GetAIPerception();
+	if (PerceptionComponent && !Controller.IsUsingSquadPerception())
+	{
+		for (auto It = PerceptionComponent->GetSensesConfigIterator(); It; ++It)
+		{
+			if (const UAISenseConfig* SenseConfig = *It)
+			{
+				PerceptionComponent->SetSenseEnabled(SenseConfig->GetSenseImplementation(), Tier.bEnablePerception);
+			}
+		}
+	}
+
+	if (const ACharacter* Character = Cast<ACharacter>(Controller.GetPawn()))
+	{
+		if (UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement())
+		{
+			MovementComponent->SetComponentTickInterval(Tier.MovementTickInterval);
+		}
+		// The significance subsystem owns animation rate where it runs.
+		USkeletalMeshComponent* MeshComponent = Character->GetMesh();
+		if (MeshComponent && GetWorld()->GetSubsystem<URsSignificanceSubsystem>() == nullptr)
+		{
+			MeshComponent->SetComponentTickInterval(Tier.AnimationTickInterval);
+		}
+	}
+}
+
+void URsAILODSubsystem::DrawDebugOverlay() const
+{
+	TArray<int32, TInlineAllocator<8>> TierCounts;
+	TierCounts.SetNumZeroed(Tiers.Num());
+	for (const FAgent& Agent : Agents)
+	{
+		if (TierCounts.IsValidIndex(Agent.Tier))
+		{
+			TierCounts[Agent.Tier]++;
+		}
+	}
+
+	FString DebugText = FString::Printf(TEXT("AI LOD (%d agents)"), Agents.Num());
+	for (int32 Index = 0; Index < TierCounts.Num(); ++Index)
+	{
+		DebugText += FString::Printf(TEXT("  Tier %d: %d"), Index, TierCounts[Index]);
+	}
+	GEngine->AddOnScreenDebugMessage(reinterpret_cast<uint64>(this), 0.f, FColor::Cyan, DebugText);
+}
@@ -0,0 +1,85 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsAILODSubsystem.generated.h"
+
+class ARsAIControllerBase;
+
+// Update rates used by AI agents in one LOD tier.
+USTRUCT()
+struct FRsAILODTier
+{
+	GENERATED_BODY()
+
+	// Agents closer to a player pawn than this distance use this tier. The last tier is used for everything farther.
+	UPROPERTY(EditAnywhere, Config)
+	float MaxDistance = 0.f;
+
+	// Minimum time between behavior tree updates. 0 means every update the tree schedules. Needs a URsBehaviorTreeComponent.
+	UPROPERTY(EditAnywhere, Config)
+	float BehaviorTreeTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, Config)
+	bool bEnablePerception = true;
+
+	UPROPERTY(EditAnywhere, Config)
+	float MovementTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, Config)
+	float AnimationTickInterval = 0.f;
+};
+
+/**
+ * Assigns AI controllers to LOD tiers by distance to the nearest player pawn and by visibility, and throttles their update rates accordingly.
+ * Tiers are re-evaluated round-robin under a per-frame budget, and settings are only applied when an agent changes tier.
+ */
+UCLASS(Config = Game)
+class RS_API URsAILODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsAILODSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void RegisterController(ARsAIControllerBase* Controller);
+	void UnregisterController(ARsAIControllerBase* Controller);
+
+	// Returns INDEX_NONE if the controller is not registered.
+	int32 GetControllerTier(const ARsAIControllerBase* Controller) const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FAgent
+	{
+		TWeakObjectPtr<ARsAIControllerBase> Controller;
+		int32 Tier = INDEX_NONE;
+	};
+
+	int32 EvaluateTier(const ARsAIControllerBase& Controller, const TArray<FVector, TInlineAllocator<4>>& PlayerLocations) const;
+	void ApplyTier(ARsAIControllerBase& Controller, const FRsAILODTier& Tier) const;
+	void DrawDebugOverlay() const;
+
+	UPROPERTY(Config)
+	TArray<FRsAILODTier> Tiers;
+
+	// Agents that are not rendered are moved this many tiers down. Ignored on dedicated servers.
+	UPROPERTY(Config)
+	int32 NotRenderedTierOffset = 1;
+
+	// Maximum number of agents whose tier is re-evaluated per frame.
+	UPROPERTY(Config)
+	int32 MaxEvaluationsPerFrame = 32;
+	
+	TArray<FAgent> Agents;
+	int32 NextEvaluationIndex = 0;
+};
@@ -0,0 +1,194 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsAttackTokenSubsystem.h"
+
+#include "Rs/AI/RsAIStats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Token Holders"), STAT_RsAttackTokenHolders, STATGROUP_RsAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Token Requests Pending"), STAT_RsAttackTokenRequestsPending, STATGROUP_RsAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Tokens Granted"), STAT_RsAttackTokensGranted, STATGROUP_RsAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Token Contention (Target Full)"), STAT_RsAttackTokenTargetFull, STATGROUP_RsAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Token Contention (Frame Budget)"), STAT_RsAttackTokenBudgetDeferred, STATGROUP_RsAI);
+
+URsAttackTokenSubsystem* URsAttackTokenSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsAttackTokenSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsAttackTokenSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool URsAttackTokenSubsystem::RequestToken(AActor* Attacker, AActor* Target, FSimpleDelegate OnGranted)
+{
+	if (Attacker == nullptr || Target == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RsAttackTokenSubsystem::RequestToken: Invalid attacker or target"));
+		return false;
+	}
+	
+	if (const TObjectKey<AActor>* HeldTarget = AttackerTargets.Find(Attacker))
+	{
+		if (*HeldTarget == TObjectKey<AActor>(Target))
+		{
+			return true;
+		}
+		ReleaseToken(Attacker);
+	}
+
+	CancelRequest(Attacker);
+	FRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.Attacker = Attacker;
+	Request.Target = Target;
+	Request.OnGranted = MoveTemp(OnGranted);
+	SET_DWORD_STAT(STAT_RsAttackTokenRequestsPending, PendingRequests.Num());
+	return false;
+}
+
+void URsAttackTokenSubsystem::CancelRequest(const AActor* Attacker)
+{
+	PendingRequests.RemoveAllSwap([Attacker](const FRequest& Request)
+	{
+		return Request.Attacker == Attacker;
+	});
+	SET_DWORD_STAT(STAT_RsAttackTokenRequestsPending, PendingRequests.Num());
+}
+
+void URsAttackTokenSubsystem::ReleaseToken(const AActor* Attacker)
+{
+	TObjectKey<AActor> HeldTarget;
+	if (!AttackerTargets.RemoveAndCopyValue(Attacker, HeldTarget))
+	{
+		return;
+	}
+	
+	if (TArray<FHolder>* Holders = TargetHolders.Find(HeldTarget))
+	{
+		Holders->RemoveAllSwap([AttackerKey = TObjectKey<AActor>(Attacker)](const FHolder& Holder)
+		{
+			return Holder.Attacker == AttackerKey;
+		});
+		if (Holders->IsEmpty())
+		{
+			TargetHolders.Remove(HeldTarget);
+		}
+	}
+	SET_DWORD_STAT(STAT_RsAttackTokenHolders, AttackerTargets.Num());
+}
+
+bool URsAttackTokenSubsystem::HasToken(const AActor* Attacker) const
+{
+	return AttackerTargets.Contains(Attacker);
+}
+
+void URsAttackTokenSubsystem::SetTargetTokenLimit(const AActor* Target, int32 Limit)
+{
+	if (Limit < 0)
+	{
+		TargetTokenLimits.Remove(Target);
+	}
+	else
+	{
+		TargetTokenLimits.Add(Target, Limit);
+	}
+}
+
+void URsAttackTokenSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ReleaseExpiredTokens();
+
+	PendingRequests.RemoveAllSwap([](const FRequest& Request)
+	{
+		return !Request.Attacker.IsValid() || !Request.Target.IsValid();
+	});
+	for (FRequest& Request : PendingRequests)
+	{
+		Request.DistanceSquared = FVector::DistSquared(Request.Attacker->GetActorLocation(), Request.Target->GetActorLocation());
+	}
+	PendingRequests.Sort([](const FRequest& A, const FRequest& B)
+	{
+		return A.DistanceSquared < B.DistanceSquared;
+	});
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	TArray<FSimpleDelegate, TInlineAllocator<8>> GrantedCallbacks;
+	for (int32 Index = 0; Index < PendingRequests.Num();)
+	{
+		FRequest& Request = PendingRequests[Index];
+		if (GrantedCallbacks.Num() >= MaxGrantsPerFrame)
+		{
+			INC_DWORD_STAT_BY(STAT_RsAttackTokenBudgetDeferred, PendingRequests.Num() - Index);
+			break;
+		}
+
+		TArray<FHolder>& Holders = TargetHolders.FindOrAdd(Request.Target.Get());
+		if (Holders.Num() >= GetTargetTokenLimit(Request.Target.Get()))
+		{
+			INC_DWORD_STAT(STAT_RsAttackTokenTargetFull);
+			++Index;
+			continue;
+		}
+
+		Holders.Add({ Request.Attacker.Get(), Now });
+		AttackerTargets.Add(Request.Attacker.Get(), Request.Target.Get());
+		GrantedCallbacks.Add(MoveTemp(Request.OnGranted));
+		// Keep the distance order for the requests still waiting.
+		PendingRequests.RemoveAt(Index, EAllowShrinking::No);
+	}
+	
+	INC_DWORD_STAT_BY(STAT_RsAttackTokensGranted, GrantedCallbacks.Num());
+	SET_DWORD_STAT(STAT_RsAttackTokenHolders, AttackerTargets.Num());
+	SET_DWORD_STAT(STAT_RsAttackTokenRequestsPending, PendingRequests.Num());
+
+	// Callbacks run last, because they activate abilities that may request or release tokens.
+	for (FSimpleDelegate& Callback : GrantedCallbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
+
+bool URsAttackTokenSubsystem::IsTickable() const
+{
+	return !PendingRequests.IsEmpty() || !AttackerTargets.IsEmpty();
+}
+
+TStatId URsAttackTokenSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsAttackTokenSubsystem, STATGROUP_Tickables);
+}
+
+int32 URsAttackTokenSubsystem::GetTargetTokenLimit(const AActor* Target) const
+{
+	const int32* Limit = TargetTokenLimits.Find(Target);
+	return Limit ? *Limit : MaxTokensPerTarget;
+}
+
+void URsAttackTokenSubsystem::ReleaseExpiredTokens()
+{
+	const double ExpireTime = GetWorld()->GetTimeSeconds() - MaxTokenHoldTime;
+	for (auto It = TargetHolders.CreateIterator(); It; ++It)
+	{
+		const bool bTargetGone = It.Key().ResolveObjectPtr() == nullptr;
+		It->Value.RemoveAllSwap([this, ExpireTime, bTargetGone](const FHolder& Holder)
+		{
+			if (bTargetGone || Holder.GrantTime < ExpireTime || Holder.Attacker.ResolveObjectPtr() == nullptr)
+			{
+				AttackerTargets.Remove(Holder.Attacker);
+				return true;
+			}
+			return false;
+		});
+		if (It->Value.IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
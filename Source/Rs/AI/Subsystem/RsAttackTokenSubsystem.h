@@ -0,0 +1,71 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsAttackTokenSubsystem.generated.h"
+
+/**
+ * Bounds how many attackers may attack the same target at once, and how many attacks may start per frame.
+ * Requests are granted at the end of the frame, closest attacker first, within the per-target limit and the global per-frame budget.
+ * An attacker holds at most one token, and releases it when its attack ability ends.
+ */
+UCLASS(Config = Game)
+class RS_API URsAttackTokenSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsAttackTokenSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Returns true if the attacker already holds a token for the target. Otherwise the request is queued, and OnGranted is called when it is granted.
+	bool RequestToken(AActor* Attacker, AActor* Target, FSimpleDelegate OnGranted);
+	void CancelRequest(const AActor* Attacker);
+	void ReleaseToken(const AActor* Attacker);
+	bool HasToken(const AActor* Attacker) const;
+
+	// Overrides MaxTokensPerTarget for one target. Negative value removes the override.
+	void SetTargetTokenLimit(const AActor* Target, int32 Limit);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FRequest
+	{
+		TWeakObjectPtr<AActor> Attacker;
+		TWeakObjectPtr<AActor> Target;
+		FSimpleDelegate OnGranted;
+		float DistanceSquared = 0.f;
+	};
+
+	struct FHolder
+	{
+		TObjectKey<AActor> Attacker;
+		double GrantTime = 0.0;
+	};
+
+	int32 GetTargetTokenLimit(const AActor* Target) const;
+	void ReleaseExpiredTokens();
+
+	UPROPERTY(Config)
+	int32 MaxTokensPerTarget = 2;
+
+	// Global budget of tokens granted per frame. Every grant starts an attack, so this bounds the activation burst.
+	UPROPERTY(Config)
+	int32 MaxGrantsPerFrame = 3;
+
+	// Safety net for holders that never release. (e.g. the granted ability failed to activate)
+	UPROPERTY(Config)
+	float MaxTokenHoldTime = 5.f;
+
+	TArray<FRequest> PendingRequests;
+	TMap<TObjectKey<AActor>, TArray<FHolder>> TargetHolders;
+	TMap<TObjectKey<AActor>, TObjectKey<AActor>> AttackerTargets;
+	TMap<TObjectKey<AActor>, int32> TargetTokenLimits;
+};
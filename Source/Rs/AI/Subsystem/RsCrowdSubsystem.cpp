@@ -0,0 +1,475 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsCrowdSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Rs/AbilitySystem/Attributes/RsHealthSet.h"
+#include "Rs/AbilitySystem/Attributes/RsStaggerSet.h"
+#include "Rs/AI/RsAIStats.h"
+#include "Rs/AI/AIController/RsAIControllerBase.h"
+#include "Rs/Battle/RsCombatStats.h"
+#include "Rs/Battle/Subsystem/RsActorHistorySubsystem.h"
+#include "Rs/Character/RsEnemyCharacter.h"
+#include "Rs/System/RsSignificanceSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Update"), STAT_RsCrowdUpdate, STATGROUP_RsAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Entities"), STAT_RsCrowdEntities, STATGROUP_RsAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Promoted Enemies"), STAT_RsCrowdPromotedEnemies, STATGROUP_RsAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Promotions"), STAT_RsCrowdPromotions, STATGROUP_RsAI);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRsCrowdSpawn(
+	TEXT("rs.Crowd.Spawn"),
+	TEXT("rs.Crowd.Spawn <Count> <EnemyClassPath> [Radius]. Spawns crowd enemies around the first player pawn. (e.g. 2000 for the crowd benchmark)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		URsCrowdSubsystem* CrowdSubsystem = World ? World->GetSubsystem<URsCrowdSubsystem>() : nullptr;
+		const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(World, 0);
+		if (CrowdSubsystem == nullptr || PlayerPawn == nullptr || Args.Num() < 2)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("rs.Crowd.Spawn: Needs a game world with a player pawn, a count and an enemy class path"));
+			return;
+		}
+
+		const TSubclassOf<ARsEnemyCharacter> EnemyClass = LoadClass<ARsEnemyCharacter>(nullptr, *Args[1]);
+		if (EnemyClass == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("rs.Crowd.Spawn: Can't load enemy class %s"), *Args[1]);
+			return;
+		}
+
+		const int32 Count = FCString::Atoi(*Args[0]);
+		const float Radius = Args.IsValidIndex(2) ? FCString::Atof(*Args[2]) : 10000.f;
+		CrowdSubsystem->SpawnCrowd(EnemyClass, PlayerPawn->GetActorLocation(), Radius, Count, EnemyClass->GetDefaultObject<ARsEnemyCharacter>()->GetGenericTeamId());
+	}));
+
+URsCrowdSubsystem* URsCrowdSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsCrowdSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsCrowdSubsystem::Deinitialize()
+{
+	SET_DWORD_STAT(STAT_RsCrowdEntities, 0);
+	SET_DWORD_STAT(STAT_RsCrowdPromotedEnemies, 0);
+	Super::Deinitialize();
+}
+
+void URsCrowdSubsystem::SpawnCrowd(TSubclassOf<ARsEnemyCharacter> EnemyClass, const FVector& Center, float Radius, int32 Count, FGenericTeamId TeamID, float Health)
+{
+	if (EnemyClass == nullptr || GetWorld()->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RsCrowdSubsystem::SpawnCrowd: Crowd needs an enemy class and authority"));
+		return;
+	}
+
+	const int32 ArchetypeIndex = FindOrAddArchetype(EnemyClass);
+	Entities.Reserve(Entities.Num() + Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector2D Offset = FMath::RandPointInCircle(Radius);
+		FEntity& Entity = Entities.AddDefaulted_GetRef();
+		Entity.Location = Center + FVector(Offset, 0.f);
+		Entity.Yaw = FMath::FRandRange(-180.f, 180.f);
+		Entity.Health = Health;
+		Entity.MaxHealth = Health;
+		Entity.TeamID = TeamID;
+		Entity.ArchetypeIndex = ArchetypeIndex;
+	}
+	bProxiesDirty = true;
+}
+
+void URsCrowdSubsystem::ApplyRadialDamage(const FVector& Center, float Radius, float Damage, float StaggerDamage, FGenericTeamId InstigatorTeamID)
+{
+	QueuedDamage.Add({ Center, Radius, Damage, StaggerDamage, InstigatorTeamID });
+}
+
+void URsCrowdSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	
+	SCOPE_CYCLE_COUNTER(STAT_RsCrowdUpdate);
+
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+
+	ApplyQueuedDamage();
+	if (!PlayerLocations.IsEmpty())
+	{
+		DemoteEnemies(PlayerLocations);
+		PromoteEntities(PlayerLocations);
+		MoveEntities(DeltaTime, PlayerLocations);
+	}
+	
+	// Nothing is drawn on a dedicated server.
+	if (bProxiesDirty && GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		UpdateProxies();
+	}
+
+	SET_DWORD_STAT(STAT_RsCrowdEntities, Entities.Num());
+	SET_DWORD_STAT(STAT_RsCrowdPromotedEnemies, Promoted.Num());
+}
+
+bool URsCrowdSubsystem::IsTickable() const
+{
+	return !Entities.IsEmpty() || !Promoted.IsEmpty() || (bProxiesDirty && GetWorld()->GetNetMode() != NM_DedicatedServer);
+}
+
+TStatId URsCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsCrowdSubsystem, STATGROUP_Tickables);
+}
+
+int32 URsCrowdSubsystem::FindOrAddArchetype(TSubclassOf<ARsEnemyCharacter> EnemyClass)
+{
+	const int32 ExistingIndex = Archetypes.IndexOfByPredicate([EnemyClass](const FArchetype& Archetype)
+	{
+		return Archetype.EnemyClass == EnemyClass;
+	});
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	FArchetype& Archetype = Archetypes.AddDefaulted_GetRef();
+	Archetype.EnemyClass = EnemyClass;
+	if (GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return Archetypes.Num() - 1;
+	}
+
+	if (ProxyActor == nullptr)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		ProxyActor = GetWorld()->SpawnActor<AActor>(SpawnParams);
+	}
+
+	if (UStaticMesh* Mesh = ProxyMesh.LoadSynchronous())
+	{
+		UInstancedStaticMeshComponent* ProxyComponent = NewObject<UInstancedStaticMeshComponent>(ProxyActor);
+		ProxyComponent->SetMobility(EComponentMobility::Movable);
+		ProxyComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		ProxyComponent->SetCastShadow(false);
+		ProxyComponent->SetStaticMesh(Mesh);
+		ProxyComponent->RegisterComponent();
+		ProxyActor->AddInstanceComponent(ProxyComponent);
+		Archetype.ProxyComponent = ProxyComponent;
+	}
+	return Archetypes.Num() - 1;
+}
+
+void URsCrowdSubsystem::ApplyQueuedDamage()
+{
+	if (QueuedDamage.IsEmpty())
+	{
+		return;
+	}
+
+	for (int32 Index = Entities.Num() - 1; Index >= 0; --Index)
+	{
+		FEntity& Entity = Entities[Index];
+		for (const FRadialDamage& RadialDamage : QueuedDamage)
+		{
+			if (Entity.TeamID != RadialDamage.InstigatorTeamID && FVector::DistSquared(Entity.Location, RadialDamage.Center) <= FMath::Square(RadialDamage.Radius))
+			{
+				Entity.Health -= RadialDamage.Damage;
+				Entity.Stagger += RadialDamage.StaggerDamage;
+			}
+		}
+		if (Entity.Health <= 0.f)
+		{
+			const FEntity DeadEntity = Entity;
+			Entities.RemoveAtSwap(Index, EAllowShrinking::No);
+			bProxiesDirty = true;
+
+			INC_DWORD_STAT(STAT_RsCombatDeaths);
+			OnCrowdEntityKilled.Broadcast(Archetypes[DeadEntity.ArchetypeIndex].EnemyClass, DeadEntity.Location, DeadEntity.TeamID);
+		}
+	}
+	QueuedDamage.Reset();
+}
+
+void URsCrowdSubsystem::MoveEntities(float DeltaTime, const TArray<FVector, TInlineAllocator<4>>& PlayerLocations)
+{
+	MovementAccumulator += DeltaTime;
+	if (MovementAccumulator < MovementUpdateInterval)
+	{
+		return;
+	}
+
+	// Stop just inside the promotion radius, where entities wait for a free promotion slot.
+	const float StopDistance = PromotionRadius * 0.9f;
+	const float MaxStep = MoveSpeed * MovementAccumulator;
+	MovementAccumulator = 0.f;
+	
+	for (FEntity& Entity : Entities)
+	{
+		const FVector* NearestLocation = nullptr;
+		float NearestDistanceSquared = TNumericLimits<float>::Max();
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			const float DistanceSquared = FVector::DistSquared2D(Entity.Location, PlayerLocation);
+			if (DistanceSquared < NearestDistanceSquared)
+			{
+				NearestDistanceSquared = DistanceSquared;
+				NearestLocation = &PlayerLocation;
+			}
+		}
+		
+		const float Distance = FMath::Sqrt(NearestDistanceSquared);
+		if (NearestLocation == nullptr || Distance <= StopDistance)
+		{
+			continue;
+		}
+
+		// Height is kept as spawned. The crowd is meant for flat arenas, and promoted enemies snap to the ground with their own movement.
+		const FVector Direction = (*NearestLocation - Entity.Location).GetSafeNormal2D();
+		Entity.Location += Direction * FMath::Min(MaxStep, Distance - StopDistance);
+		Entity.Yaw = Direction.Rotation().Yaw;
+	}
+	bProxiesDirty = true;
+}
+
+void URsCrowdSubsystem::PromoteEntities(const TArray<FVector, TInlineAllocator<4>>& PlayerLocations)
+{
+	const int32 NumPromotions = FMath::Min(MaxPromotionsPerFrame, MaxPromotedEnemies - Promoted.Num());
+	if (NumPromotions <= 0)
+	{
+		return;
+	}
+
+	TArray<TPair<float, int32>> Candidates;
+	for (int32 Index = 0; Index < Entities.Num(); ++Index)
+	{
+		const float DistanceSquared = GetMinDistanceSquared(Entities[Index].Location, PlayerLocations);
+		if (DistanceSquared <= FMath::Square(PromotionRadius))
+		{
+			Candidates.Emplace(DistanceSquared, Index);
+		}
+	}
+	if (Candidates.IsEmpty())
+	{
+		return;
+	}
+
+	// Closest first, then remove from the back so that swapped indices stay valid.
+	Candidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+	Candidates.SetNum(FMath::Min(Candidates.Num(), NumPromotions));
+	Candidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Value > B.Value; });
+
+	for (const TPair<float, int32>& Candidate : Candidates)
+	{
+		const FEntity Entity = Entities[Candidate.Value];
+		Entities.RemoveAtSwap(Candidate.Value, EAllowShrinking::No);
+		
+		ARsEnemyCharacter* Enemy = AcquireEnemy(Entity.ArchetypeIndex, Entity.Location, Entity.TeamID);
+		if (Enemy == nullptr)
+		{
+			continue;
+		}
+		Enemy->SetActorRotation(FRotator(0.f, Entity.Yaw, 0.f));
+
+		if (UAbilitySystemComponent* AbilitySystemComponent = Enemy->GetAbilitySystemComponent())
+		{
+			const float MaxHealth = AbilitySystemComponent->GetNumericAttribute(URsHealthSet::GetMaxHealthAttribute());
+			AbilitySystemComponent->SetNumericAttributeBase(URsHealthSet::GetCurrentHealthAttribute(), MaxHealth * Entity.Health / Entity.MaxHealth);
+			AbilitySystemComponent->SetNumericAttributeBase(URsStaggerSet::GetCurrentStaggerAttribute(), Entity.Stagger);
+		}
+		Promoted.Add({ Enemy, Entity.MaxHealth, Entity.ArchetypeIndex });
+		INC_DWORD_STAT(STAT_RsCrowdPromotions);
+	}
+	bProxiesDirty = true;
+}
+
+void URsCrowdSubsystem::DemoteEnemies(const TArray<FVector, TInlineAllocator<4>>& PlayerLocations)
+{
+	for (int32 Index = Promoted.Num() - 1; Index >= 0; --Index)
+	{
+		const FPromotedEnemy PromotedEnemy = Promoted[Index];
+		ARsEnemyCharacter* Enemy = PromotedEnemy.Enemy.Get();
+		if (Enemy == nullptr)
+		{
+			Promoted.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const UAbilitySystemComponent* AbilitySystemComponent = Enemy->GetAbilitySystemComponent();
+		const float CurrentHealth = AbilitySystemComponent ? AbilitySystemComponent->GetNumericAttribute(URsHealthSet::GetCurrentHealthAttribute()) : 0.f;
+		const float MaxHealth = AbilitySystemComponent ? AbilitySystemComponent->GetNumericAttribute(URsHealthSet::GetMaxHealthAttribute()) : 0.f;
+		if (CurrentHealth <= 0.f || MaxHealth <= 0.f)
+		{
+			// The death ability keeps playing, but the slot goes to the next promotion. The health set already counted the death.
+			if (Enemy->GetLifeSpan() <= 0.f)
+			{
+				Enemy->SetLifeSpan(DeadEnemyLifeSpan);
+			}
+			Promoted.RemoveAtSwap(Index);
+			continue;
+		}
+		if (GetMinDistanceSquared(Enemy->GetActorLocation(), PlayerLocations) <= FMath::Square(DemotionRadius))
+		{
+			continue;
+		}
+
+		FEntity& Entity = Entities.AddDefaulted_GetRef();
+		Entity.Location = Enemy->GetActorLocation();
+		Entity.Yaw = Enemy->GetActorRotation().Yaw;
+		Entity.MaxHealth = PromotedEnemy.CrowdMaxHealth;
+		Entity.Health = PromotedEnemy.CrowdMaxHealth * CurrentHealth / MaxHealth;
+		Entity.Stagger = AbilitySystemComponent->GetNumericAttribute(URsStaggerSet::GetCurrentStaggerAttribute());
+		Entity.TeamID = Enemy->GetGenericTeamId();
+		Entity.ArchetypeIndex = PromotedEnemy.ArchetypeIndex;
+
+		ReleaseEnemy(*Enemy, PromotedEnemy.ArchetypeIndex);
+		Promoted.RemoveAtSwap(Index);
+		bProxiesDirty = true;
+	}
+}
+
+ARsEnemyCharacter* URsCrowdSubsystem::AcquireEnemy(int32 ArchetypeIndex, const FVector& Location, FGenericTeamId TeamID)
+{
+	FArchetype& Archetype = Archetypes[ArchetypeIndex];
+	while (!Archetype.Pool.IsEmpty())
+	{
+		ARsEnemyCharacter* Enemy = Archetype.Pool.Pop(EAllowShrinking::No).Get();
+		if (Enemy == nullptr)
+		{
+			continue;
+		}
+
+		Enemy->SetActorLocation(Location, false, nullptr, ETeleportType::ResetPhysics);
+		Enemy->SetGenericTeamId(TeamID);
+		Enemy->SetActorHiddenInGame(false);
+		Enemy->SetActorEnableCollision(true);
+		Enemy->SetActorTickEnabled(true);
+		Enemy->GetCharacterMovement()->Activate();
+		SetPooledEnemyRegistered(*Enemy, true);
+		return Enemy;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	ARsEnemyCharacter* Enemy = GetWorld()->SpawnActor<ARsEnemyCharacter>(Archetype.EnemyClass, Location, FRotator::ZeroRotator, SpawnParams);
+	if (Enemy)
+	{
+		Enemy->SetGenericTeamId(TeamID);
+		if (Enemy->GetController() == nullptr)
+		{
+			Enemy->SpawnDefaultController();
+		}
+	}
+	return Enemy;
+}
+
+void URsCrowdSubsystem::ReleaseEnemy(ARsEnemyCharacter& Enemy, int32 ArchetypeIndex)
+{
+	if (UAbilitySystemComponent* AbilitySystemComponent = Enemy.GetAbilitySystemComponent())
+	{
+		AbilitySystemComponent->CancelAllAbilities();
+	}
+	SetPooledEnemyRegistered(Enemy, false);
+	Enemy.GetCharacterMovement()->StopMovementImmediately();
+	Enemy.GetCharacterMovement()->Deactivate();
+	Enemy.SetActorTickEnabled(false);
+	Enemy.SetActorEnableCollision(false);
+	Enemy.SetActorHiddenInGame(true);
+	
+	Archetypes[ArchetypeIndex].Pool.Add(&Enemy);
+}
+
+void URsCrowdSubsystem::SetPooledEnemyRegistered(ARsEnemyCharacter& Enemy, bool bRegistered)
+{
+	// Dormancy pauses the behavior tree and leaves the AI LOD, squad perception and player pawn subsystems.
+	if (ARsAIControllerBase* AIController = Cast<ARsAIControllerBase>(Enemy.GetController()))
+	{
+		AIController->SetDormant(!bRegistered);
+	}
+
+	URsActorHistorySubsystem* ActorHistorySubsystem = URsActorHistorySubsystem::Get(this);
+	URsSignificanceSubsystem* SignificanceSubsystem = URsSignificanceSubsystem::Get(this);
+	if (bRegistered)
+	{
+		if (ActorHistorySubsystem)
+		{
+			ActorHistorySubsystem->RegisterActor(&Enemy);
+		}
+		if (SignificanceSubsystem)
+		{
+			SignificanceSubsystem->RegisterCharacter(&Enemy);
+		}
+	}
+	else
+	{
+		if (ActorHistorySubsystem)
+		{
+			ActorHistorySubsystem->UnregisterActor(&Enemy);
+		}
+		if (SignificanceSubsystem)
+		{
+			SignificanceSubsystem->UnregisterCharacter(&Enemy);
+		}
+	}
+}
+
+void URsCrowdSubsystem::UpdateProxies()
+{
+	bProxiesDirty = false;
+	
+	TArray<TArray<FTransform>, TInlineAllocator<4>> ArchetypeTransforms;
+	ArchetypeTransforms.SetNum(Archetypes.Num());
+	for (const FEntity& Entity : Entities)
+	{
+		ArchetypeTransforms[Entity.ArchetypeIndex].Emplace(FRotator(0.f, Entity.Yaw, 0.f), Entity.Location);
+	}
+
+	for (int32 Index = 0; Index < Archetypes.Num(); ++Index)
+	{
+		UInstancedStaticMeshComponent* ProxyComponent = Archetypes[Index].ProxyComponent.Get();
+		if (ProxyComponent == nullptr)
+		{
+			continue;
+		}
+		
+		// Only moves are cheap to batch. Count changes (promotion, death) rebuild the instances.
+		const TArray<FTransform>& Transforms = ArchetypeTransforms[Index];
+		if (ProxyComponent->GetInstanceCount() == Transforms.Num())
+		{
+			ProxyComponent->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+		}
+		else
+		{
+			ProxyComponent->ClearInstances();
+			ProxyComponent->AddInstances(Transforms, false, true, false);
+		}
+	}
+}
+
+float URsCrowdSubsystem::GetMinDistanceSquared(const FVector& Location, const TArray<FVector, TInlineAllocator<4>>& PlayerLocations)
+{
+	float MinDistanceSquared = TNumericLimits<float>::Max();
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(Location, PlayerLocation));
+	}
+	return MinDistanceSquared;
+}
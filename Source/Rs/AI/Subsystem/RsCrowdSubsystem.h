@@ -0,0 +1,139 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericTeamAgentInterface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsCrowdSubsystem.generated.h"
+
+class ARsEnemyCharacter;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+// Crowd entities die without an actor or a health set, so this stands in for their death event.
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FRsCrowdEntityKilled, TSubclassOf<ARsEnemyCharacter> /*EnemyClass*/, const FVector& /*Location*/, FGenericTeamId /*TeamID*/);
+
+/**
+ * Cheap representation for large numbers of background enemies.
+ * Crowd entities are plain data (location, health, stagger, team) moved in one batched pass and drawn as instanced proxy meshes.
+ * Entities near a player pawn are promoted to full ARsEnemyCharacter actors, which are pooled and demoted back into the crowd when far away.
+ * Runs on the authority only.
+ */
+UCLASS(Config = Game)
+class RS_API URsCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsCrowdSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// Scatters crowd entities in a disc around the center.
+	void SpawnCrowd(TSubclassOf<ARsEnemyCharacter> EnemyClass, const FVector& Center, float Radius, int32 Count, FGenericTeamId TeamID, float Health = 100.f);
+
+	// Queued, and applied to every crowd entity in the radius that isn't on the instigator's team in the next crowd update.
+	// Melee abilities with a crowd damage radius call this from their area damage. (e.g. skills and ultimates)
+	void ApplyRadialDamage(const FVector& Center, float Radius, float Damage, float StaggerDamage, FGenericTeamId InstigatorTeamID);
+
+	int32 GetNumCrowdEntities() const { return Entities.Num(); }
+	int32 GetNumPromotedEnemies() const { return Promoted.Num(); }
+
+	FRsCrowdEntityKilled OnCrowdEntityKilled;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FEntity
+	{
+		FVector Location = FVector::ZeroVector;
+		float Yaw = 0.f;
+		float Health = 0.f;
+		float MaxHealth = 0.f;
+		float Stagger = 0.f;
+		FGenericTeamId TeamID;
+		int32 ArchetypeIndex = INDEX_NONE;
+	};
+
+	struct FArchetype
+	{
+		TSubclassOf<ARsEnemyCharacter> EnemyClass;
+		TWeakObjectPtr<UInstancedStaticMeshComponent> ProxyComponent;
+		TArray<TWeakObjectPtr<ARsEnemyCharacter>> Pool;
+	};
+
+	struct FPromotedEnemy
+	{
+		TWeakObjectPtr<ARsEnemyCharacter> Enemy;
+		float CrowdMaxHealth = 0.f;
+		int32 ArchetypeIndex = INDEX_NONE;
+	};
+
+	struct FRadialDamage
+	{
+		FVector Center;
+		float Radius;
+		float Damage;
+		float StaggerDamage;
+		FGenericTeamId InstigatorTeamID;
+	};
+
+	int32 FindOrAddArchetype(TSubclassOf<ARsEnemyCharacter> EnemyClass);
+	void ApplyQueuedDamage();
+	void MoveEntities(float DeltaTime, const TArray<FVector, TInlineAllocator<4>>& PlayerLocations);
+	void PromoteEntities(const TArray<FVector, TInlineAllocator<4>>& PlayerLocations);
+	void DemoteEnemies(const TArray<FVector, TInlineAllocator<4>>& PlayerLocations);
+	ARsEnemyCharacter* AcquireEnemy(int32 ArchetypeIndex, const FVector& Location, FGenericTeamId TeamID);
+	void ReleaseEnemy(ARsEnemyCharacter& Enemy, int32 ArchetypeIndex);
+
+	// Pooled enemies leave every per-character subsystem, so hidden actors cost nothing there.
+	void SetPooledEnemyRegistered(ARsEnemyCharacter& Enemy, bool bRegistered);
+	void UpdateProxies();
+
+	static float GetMinDistanceSquared(const FVector& Location, const TArray<FVector, TInlineAllocator<4>>& PlayerLocations);
+
+	// Crowd entities closer than this to a player pawn become full enemies.
+	UPROPERTY(Config)
+	float PromotionRadius = 2500.f;
+
+	// Promoted enemies farther than this from every player pawn go back to the crowd. Larger than PromotionRadius to avoid flickering.
+	UPROPERTY(Config)
+	float DemotionRadius = 3500.f;
+
+	UPROPERTY(Config)
+	int32 MaxPromotedEnemies = 40;
+
+	UPROPERTY(Config)
+	int32 MaxPromotionsPerFrame = 4;
+
+	// Dead promoted enemies give up their slot right away, and are destroyed after this time to finish their death ability.
+	UPROPERTY(Config)
+	float DeadEnemyLifeSpan = 5.f;
+
+	UPROPERTY(Config)
+	float MoveSpeed = 300.f;
+
+	// Crowd movement is updated at this interval, as distant entities don't need per-frame movement.
+	UPROPERTY(Config)
+	float MovementUpdateInterval = 0.1f;
+
+	// Drawn at the entity location, which is where the promoted character's capsule center goes.
+	UPROPERTY(Config)
+	TSoftObjectPtr<UStaticMesh> ProxyMesh;
+
+	TArray<FEntity> Entities;
+	TArray<FArchetype> Archetypes;
+	TArray<FPromotedEnemy> Promoted;
+	TArray<FRadialDamage> QueuedDamage;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> ProxyActor;
+
+	float MovementAccumulator = 0.f;
+	bool bProxiesDirty = false;
+};
@@ -0,0 +1,302 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsPathRequestSubsystem.h"
+
+#include "AIController.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Rs/AI/RsAIStats.h"
+#include "Rs/AI/AIController/RsAIControllerBase.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests"), STAT_RsPathRequests, STATGROUP_RsAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Merged"), STAT_RsPathRequestsMerged, STATGROUP_RsAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Cache Hits"), STAT_RsPathCacheHits, STATGROUP_RsAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Queries Dispatched"), STAT_RsPathQueriesDispatched, STATGROUP_RsAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Path Queries Queued"), STAT_RsPathQueriesQueued, STATGROUP_RsAI);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Path Queue Latency (ms)"), STAT_RsPathQueueLatency, STATGROUP_RsAI);
+
+URsPathRequestSubsystem* URsPathRequestSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsPathRequestSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsPathRequestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool URsPathRequestSubsystem::TryGetCachedPath(AAIController* Controller, const FVector& Goal, FNavPathSharedPtr& OutPath)
+{
+	if (Controller == nullptr)
+	{
+		return false;
+	}
+	
+	const FCachedPath* CachedPath = Cache.Find(MakeQueryKey(*Controller, Goal));
+	if (CachedPath == nullptr || !CachedPath->Path.IsValid() || GetWorld()->GetTimeSeconds() - CachedPath->Time > CacheLifetime)
+	{
+		return false;
+	}
+
+	OutPath = MakeCorridorPath(*CachedPath->Path, CachedPath->Start, *Controller);
+	if (OutPath.IsValid())
+	{
+		INC_DWORD_STAT(STAT_RsPathCacheHits);
+		return true;
+	}
+	return false;
+}
+
+uint32 URsPathRequestSubsystem::RequestPath(AAIController* Controller, const FVector& Goal, FRsPathReadyDelegate OnReady)
+{
+	if (Controller == nullptr || Controller->GetPawn() == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RsPathRequestSubsystem::RequestPath: Controller has no pawn"));
+		return 0;
+	}
+	
+	INC_DWORD_STAT(STAT_RsPathRequests);
+	
+	FRequester Requester;
+	Requester.RequestID = NextRequestID++;
+	Requester.Controller = Controller;
+	Requester.OnReady = MoveTemp(OnReady);
+	Requester.RequestTime = GetWorld()->GetTimeSeconds();
+	if (NextRequestID == 0)
+	{
+		NextRequestID = 1;
+	}
+	
+	const uint32 RequestID = Requester.RequestID;
+	AddRequester(MakeQueryKey(*Controller, Goal), Goal, MoveTemp(Requester));
+	return RequestID;
+}
+
+void URsPathRequestSubsystem::CancelRequest(uint32 RequestID)
+{
+	if (RequestID == 0)
+	{
+		return;
+	}
+	
+	for (TPair<FQueryKey, FQuery>& Pair : Queries)
+	{
+		const int32 NumRemoved = Pair.Value.Requesters.RemoveAll([RequestID](const FRequester& Requester)
+		{
+			return Requester.RequestID == RequestID;
+		});
+		if (NumRemoved > 0)
+		{
+			// An empty query stays until its result arrives or its dispatch turn comes, and is dropped then.
+			return;
+		}
+	}
+}
+
+void URsPathRequestSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	int32 NumDispatched = 0;
+	while (NumDispatched < MaxQueriesPerFrame && !DispatchQueue.IsEmpty())
+	{
+		const FQueryKey Key = DispatchQueue.First();
+		DispatchQueue.PopFirst();
+
+		FQuery* Query = Queries.Find(Key);
+		if (Query == nullptr)
+		{
+			continue;
+		}
+		if (Query->Requesters.IsEmpty() || !DispatchQuery(Key, *Query))
+		{
+			for (FRequester& Requester : Query->Requesters)
+			{
+				Requester.OnReady.ExecuteIfBound(nullptr);
+			}
+			Queries.Remove(Key);
+			continue;
+		}
+		++NumDispatched;
+	}
+	INC_DWORD_STAT_BY(STAT_RsPathQueriesDispatched, NumDispatched);
+	SET_DWORD_STAT(STAT_RsPathQueriesQueued, DispatchQueue.Num());
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (auto It = Cache.CreateIterator(); It; ++It)
+	{
+		if (Now - It->Value.Time > CacheLifetime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool URsPathRequestSubsystem::IsTickable() const
+{
+	return !DispatchQueue.IsEmpty() || !Cache.IsEmpty();
+}
+
+TStatId URsPathRequestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsPathRequestSubsystem, STATGROUP_Tickables);
+}
+
+URsPathRequestSubsystem::FQueryKey URsPathRequestSubsystem::MakeQueryKey(const AAIController& Controller, const FVector& Goal) const
+{
+	FQueryKey Key;
+	Key.GoalCell = FIntVector(FMath::FloorToInt(Goal.X / GoalCellSize), FMath::FloorToInt(Goal.Y / GoalCellSize), FMath::FloorToInt(Goal.Z / GoalCellSize));
+	if (const ARsAIControllerBase* RsController = Cast<ARsAIControllerBase>(&Controller))
+	{
+		Key.GroupName = RsController->GetSquadName();
+	}
+	return Key;
+}
+
+void URsPathRequestSubsystem::AddRequester(const FQueryKey& Key, const FVector& Goal, FRequester&& Requester)
+{
+	if (FQuery* Query = Queries.Find(Key))
+	{
+		INC_DWORD_STAT(STAT_RsPathRequestsMerged);
+		Query->Requesters.Add(MoveTemp(Requester));
+		return;
+	}
+	
+	FQuery& Query = Queries.Add(Key);
+	Query.Goal = Goal;
+	Query.Requesters.Add(MoveTemp(Requester));
+	DispatchQueue.PushLast(Key);
+}
+
+bool URsPathRequestSubsystem::DispatchQuery(const FQueryKey& Key, FQuery& Query)
+{
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	AAIController* Controller = nullptr;
+	for (const FRequester& Requester : Query.Requesters)
+	{
+		if (Requester.Controller.IsValid() && Requester.Controller->GetPawn())
+		{
+			Controller = Requester.Controller.Get();
+			break;
+		}
+	}
+	if (NavigationSystem == nullptr || Controller == nullptr)
+	{
+		return false;
+	}
+
+	// The first requester is the query start. The rest follow its corridor.
+	const FNavAgentProperties& AgentProperties = Controller->GetNavAgentPropertiesRef();
+	Query.Start = Controller->GetNavAgentLocation();
+	const ANavigationData* NavData = NavigationSystem->GetNavDataForProps(AgentProperties, Query.Start);
+	if (NavData == nullptr)
+	{
+		return false;
+	}
+
+	const FSharedConstNavQueryFilter QueryFilter = UNavigationQueryFilter::GetQueryFilter(*NavData, Controller, Controller->GetDefaultNavigationFilterClass());
+	const FPathFindingQuery PathFindingQuery(Controller, *NavData, Query.Start, Query.Goal, QueryFilter);
+	Query.NavQueryID = NavigationSystem->FindPathAsync(AgentProperties, PathFindingQuery, FNavPathQueryDelegate::CreateUObject(this, &ThisClass::HandlePathFound), EPathFindingMode::Regular);
+	if (Query.NavQueryID == INVALID_NAVQUERYID)
+	{
+		return false;
+	}
+	
+	NavQueryKeys.Add(Query.NavQueryID, Key);
+	return true;
+}
+
+void URsPathRequestSubsystem::HandlePathFound(uint32 NavQueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FQueryKey Key;
+	if (!NavQueryKeys.RemoveAndCopyValue(NavQueryID, Key))
+	{
+		return;
+	}
+	
+	FQuery Query;
+	if (!Queries.RemoveAndCopyValue(Key, Query))
+	{
+		return;
+	}
+	
+	const bool bSucceeded = Result == ENavigationQueryResult::Success && Path.IsValid() && Path->IsValid();
+	if (bSucceeded)
+	{
+		FCachedPath& CachedPath = Cache.Add(Key);
+		CachedPath.Path = Path;
+		CachedPath.Start = Query.Start;
+		CachedPath.Time = GetWorld()->GetTimeSeconds();
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	double TotalLatency = 0.0;
+	int32 NumDelivered = 0;
+	for (FRequester& Requester : Query.Requesters)
+	{
+		AAIController* Controller = Requester.Controller.Get();
+		if (Controller == nullptr)
+		{
+			continue;
+		}
+		
+		FNavPathSharedPtr RequesterPath = bSucceeded ? MakeCorridorPath(*Path, Query.Start, *Controller) : nullptr;
+		if (bSucceeded && !RequesterPath.IsValid())
+		{
+			// Too far from the shared start. Queue its own query, keyed by the controller so it isn't merged again.
+			FQueryKey OwnKey = Key;
+			OwnKey.GroupName = Controller->GetFName();
+			AddRequester(OwnKey, Query.Goal, MoveTemp(Requester));
+			continue;
+		}
+		
+		TotalLatency += Now - Requester.RequestTime;
+		++NumDelivered;
+		Requester.OnReady.ExecuteIfBound(RequesterPath);
+	}
+
+	if (NumDelivered > 0)
+	{
+		SET_FLOAT_STAT(STAT_RsPathQueueLatency, TotalLatency * 1000.0 / NumDelivered);
+	}
+}
+
+FNavPathSharedPtr URsPathRequestSubsystem::MakeCorridorPath(const FNavigationPath& SourcePath, const FVector& SourceStart, const AAIController& Controller) const
+{
+	const FVector Location = Controller.GetNavAgentLocation();
+	if (FVector::DistSquared(Location, SourceStart) > FMath::Square(CorridorShareRadius))
+	{
+		return nullptr;
+	}
+
+	const TArray<FNavPathPoint>& SourcePoints = SourcePath.GetPathPoints();
+	if (SourcePoints.Num() < 2)
+	{
+		return nullptr;
+	}
+	
+	// Join the corridor at the first point ahead of the requester, so it doesn't walk back to the shared start.
+	int32 JoinIndex = 1;
+	while (JoinIndex < SourcePoints.Num() - 1 && FVector::DistSquared(Location, SourcePoints[JoinIndex + 1].Location) < FVector::DistSquared(SourcePoints[JoinIndex].Location, SourcePoints[JoinIndex + 1].Location))
+	{
+		++JoinIndex;
+	}
+
+	TArray<FVector> Points;
+	Points.Reserve(SourcePoints.Num() - JoinIndex + 1);
+	Points.Add(Location);
+	for (int32 Index = JoinIndex; Index < SourcePoints.Num(); ++Index)
+	{
+		Points.Add(SourcePoints[Index].Location);
+	}
+
+	FNavPathSharedPtr Path = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Points);
+	Path->SetNavigationDataUsed(SourcePath.GetNavigationDataUsed());
+	Path->SetQuerier(&Controller);
+	return Path;
+}
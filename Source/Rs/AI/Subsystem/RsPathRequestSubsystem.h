@@ -0,0 +1,102 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Deque.h"
+#include "NavigationData.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsPathRequestSubsystem.generated.h"
+
+class AAIController;
+
+// Called with an invalid path when no path could be found.
+DECLARE_DELEGATE_OneParam(FRsPathReadyDelegate, FNavPathSharedPtr /*Path*/);
+
+/**
+ * Schedules navmesh path queries for AI.
+ * Requests toward the same goal cell from the same squad are merged into one async query, queries are dispatched under a per-frame budget,
+ * and the result is shared as a corridor with every requester close to the query start. Recent results are cached for later requesters.
+ */
+UCLASS(Config = Game)
+class RS_API URsPathRequestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsPathRequestSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Returns a copy of a recent path toward the goal, if one can be shared with the controller.
+	bool TryGetCachedPath(AAIController* Controller, const FVector& Goal, FNavPathSharedPtr& OutPath);
+
+	// Returns the request ID, or 0 if the request is invalid. OnReady is called from a later tick.
+	uint32 RequestPath(AAIController* Controller, const FVector& Goal, FRsPathReadyDelegate OnReady);
+	void CancelRequest(uint32 RequestID);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FQueryKey
+	{
+		FName GroupName;
+		FIntVector GoalCell;
+
+		bool operator==(const FQueryKey& Other) const { return GroupName == Other.GroupName && GoalCell == Other.GoalCell; }
+		friend uint32 GetTypeHash(const FQueryKey& Key) { return HashCombine(GetTypeHash(Key.GroupName), GetTypeHash(Key.GoalCell)); }
+	};
+
+	struct FRequester
+	{
+		uint32 RequestID = 0;
+		TWeakObjectPtr<AAIController> Controller;
+		FRsPathReadyDelegate OnReady;
+		double RequestTime = 0.0;
+	};
+
+	struct FQuery
+	{
+		FVector Goal = FVector::ZeroVector;
+		TArray<FRequester> Requesters;
+		uint32 NavQueryID = INVALID_NAVQUERYID;
+		FVector Start = FVector::ZeroVector;
+	};
+
+	struct FCachedPath
+	{
+		FNavPathSharedPtr Path;
+		FVector Start = FVector::ZeroVector;
+		double Time = 0.0;
+	};
+
+	FQueryKey MakeQueryKey(const AAIController& Controller, const FVector& Goal) const;
+	bool DispatchQuery(const FQueryKey& Key, FQuery& Query);
+	void HandlePathFound(uint32 NavQueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	FNavPathSharedPtr MakeCorridorPath(const FNavigationPath& SourcePath, const FVector& SourceStart, const AAIController& Controller) const;
+	void AddRequester(const FQueryKey& Key, const FVector& Goal, FRequester&& Requester);
+
+	// Goals in the same cell share one query.
+	UPROPERTY(Config)
+	float GoalCellSize = 200.f;
+
+	// Requesters within this distance of the query start follow the shared corridor. Others get their own query.
+	UPROPERTY(Config)
+	float CorridorShareRadius = 600.f;
+
+	UPROPERTY(Config)
+	float CacheLifetime = 0.5f;
+
+	UPROPERTY(Config)
+	int32 MaxQueriesPerFrame = 8;
+
+	TMap<FQueryKey, FQuery> Queries;
+	// FIFO. A deque, so a long drain doesn't shift the remaining keys on every dispatch.
+	TDeque<FQueryKey> DispatchQueue;
+	TMap<uint32, FQueryKey> NavQueryKeys;
+	TMap<FQueryKey, FCachedPath> Cache;
+	uint32 NextRequestID = 1;
+};
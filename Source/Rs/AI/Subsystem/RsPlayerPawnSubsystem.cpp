@@ -0,0 +1,178 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsPlayerPawnSubsystem.h"
+
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Engine/GameInstance.h"
+
+URsPlayerPawnSubsystem* URsPlayerPawnSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsPlayerPawnSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsPlayerPawnSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsPlayerPawnSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UGameInstance* GameInstance = InWorld.GetGameInstance())
+	{
+		GameInstance->OnPawnControllerChangedDelegates.AddDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+	bPlayerPawnsDirty = true;
+}
+
+void URsPlayerPawnSubsystem::Deinitialize()
+{
+	if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+	{
+		GameInstance->OnPawnControllerChangedDelegates.RemoveDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+	Super::Deinitialize();
+}
+
+APawn* URsPlayerPawnSubsystem::FindNearestPlayerPawn(const FVector& Location) const
+{
+	if (PlayerPawns.Num() == 1)
+	{
+		return PlayerPawns[0].Get();
+	}
+	
+	APawn* NearestPawn = nullptr;
+	float NearestDistanceSquared = TNumericLimits<float>::Max();
+	for (const TWeakObjectPtr<APawn>& PlayerPawn : PlayerPawns)
+	{
+		if (APawn* Pawn = PlayerPawn.Get())
+		{
+			const float DistanceSquared = FVector::DistSquared(Pawn->GetActorLocation(), Location);
+			if (DistanceSquared < NearestDistanceSquared)
+			{
+				NearestPawn = Pawn;
+				NearestDistanceSquared = DistanceSquared;
+			}
+		}
+	}
+	return NearestPawn;
+}
+
+void URsPlayerPawnSubsystem::RegisterBlackboard(UBlackboardComponent* BlackboardComponent)
+{
+	if (BlackboardComponent == nullptr)
+	{
+		return;
+	}
+
+	const FBlackboard::FKey Key = BlackboardComponent->GetKeyID(PlayerPawnKeyName);
+	if (Key == FBlackboard::InvalidKey)
+	{
+		return;
+	}
+
+	UnregisterBlackboard(BlackboardComponent);
+	Blackboards.Add({ BlackboardComponent, Key });
+	if (!bPlayerPawnsDirty)
+	{
+		WriteBlackboard(*BlackboardComponent, Key);
+	}
+}
+
+void URsPlayerPawnSubsystem::UnregisterBlackboard(UBlackboardComponent* BlackboardComponent)
+{
+	Blackboards.RemoveAllSwap([BlackboardComponent](const FRegisteredBlackboard& Entry)
+	{
+		return Entry.BlackboardComponent == BlackboardComponent;
+	});
+}
+
+void URsPlayerPawnSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_RsPlayerPawnBroadcast);
+
+	if (bPlayerPawnsDirty)
+	{
+		bPlayerPawnsDirty = false;
+		RefreshPlayerPawns();
+		WriteBlackboards();
+		OnPlayerPawnsChanged.Broadcast();
+		return;
+	}
+
+	// Players move, so which pawn is nearest to each agent changes without any possession change.
+	TimeSinceNearestPawnRefresh += DeltaTime;
+	if (TimeSinceNearestPawnRefresh >= NearestPawnRefreshInterval)
+	{
+		WriteBlackboards();
+	}
+}
+
+bool URsPlayerPawnSubsystem::IsTickable() const
+{
+	return bPlayerPawnsDirty || (PlayerPawns.Num() > 1 && !Blackboards.IsEmpty());
+}
+
+TStatId URsPlayerPawnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsPlayerPawnSubsystem, STATGROUP_Tickables);
+}
+
+void URsPlayerPawnSubsystem::HandlePawnControllerChanged(APawn* Pawn, AController* Controller)
+{
+	// Only the new controller is passed, so a pawn leaving a player is seen as an AI controller change.
+	if (Controller == nullptr || Controller->IsPlayerController() || PlayerPawns.Contains(Pawn))
+	{
+		bPlayerPawnsDirty = true;
+	}
+}
+
+void URsPlayerPawnSubsystem::RefreshPlayerPawns()
+{
+	PlayerPawns.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerPawns.Add(PlayerPawn);
+		}
+	}
+}
+
+void URsPlayerPawnSubsystem::WriteBlackboards()
+{
+	TimeSinceNearestPawnRefresh = 0.f;
+	for (int32 Index = Blackboards.Num() - 1; Index >= 0; --Index)
+	{
+		if (UBlackboardComponent* BlackboardComponent = Blackboards[Index].BlackboardComponent.Get())
+		{
+			WriteBlackboard(*BlackboardComponent, Blackboards[Index].Key);
+		}
+		else
+		{
+			Blackboards.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void URsPlayerPawnSubsystem::WriteBlackboard(UBlackboardComponent& BlackboardComponent, FBlackboard::FKey Key) const
+{
+	const AAIController* AIController = Cast<AAIController>(BlackboardComponent.GetOwner());
+	const APawn* AIPawn = AIController ? AIController->GetPawn() : nullptr;
+	
+	// Keep the last known pawn while no player controls one. (e.g. in the middle of a switch)
+	if (APawn* PlayerPawn = FindNearestPlayerPawn(AIPawn ? AIPawn->GetActorLocation() : FVector::ZeroVector))
+	{
+		BlackboardComponent.SetValue<UBlackboardKeyType_Object>(Key, PlayerPawn);
+	}
+}
@@ -0,0 +1,72 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsPlayerPawnSubsystem.generated.h"
+
+class UBlackboardComponent;
+
+DECLARE_MULTICAST_DELEGATE(FRsPlayerPawnsChangedSignature);
+
+/**
+ * Owns the pawns currently controlled by players, and broadcasts them to registered AI blackboards.
+ * Possession changes within a frame (e.g. party switch) are coalesced into a single pass over the blackboards.
+ * With more than one player pawn, the nearest one is also refreshed at a fixed interval as players move.
+ */
+UCLASS(Config = Game)
+class RS_API URsPlayerPawnSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsPlayerPawnSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	const TArray<TWeakObjectPtr<APawn>>& GetPlayerPawns() const { return PlayerPawns; }
+
+	// Player pawn closest to the location. Null if no player controls a pawn.
+	APawn* FindNearestPlayerPawn(const FVector& Location) const;
+
+	// Blackboards without the player pawn key are ignored.
+	void RegisterBlackboard(UBlackboardComponent* BlackboardComponent);
+	void UnregisterBlackboard(UBlackboardComponent* BlackboardComponent);
+
+	FRsPlayerPawnsChangedSignature OnPlayerPawnsChanged;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* Controller);
+
+	void RefreshPlayerPawns();
+	void WriteBlackboards();
+	void WriteBlackboard(UBlackboardComponent& BlackboardComponent, FBlackboard::FKey Key) const;
+
+	UPROPERTY(Config)
+	FName PlayerPawnKeyName = TEXT("PlayerControllingPawn");
+
+	// Seconds between re-picking the nearest player pawn, when there is more than one.
+	UPROPERTY(Config)
+	float NearestPawnRefreshInterval = 0.5f;
+
+	struct FRegisteredBlackboard
+	{
+		TWeakObjectPtr<UBlackboardComponent> BlackboardComponent;
+		FBlackboard::FKey Key = FBlackboard::InvalidKey;
+	};
+	TArray<FRegisteredBlackboard> Blackboards;
+	
+	TArray<TWeakObjectPtr<APawn>> PlayerPawns;
+	bool bPlayerPawnsDirty = false;
+	float TimeSinceNearestPawnRefresh = 0.f;
+};
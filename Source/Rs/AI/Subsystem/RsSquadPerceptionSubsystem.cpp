@@ -0,0 +1,328 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsSquadPerceptionSubsystem.h"
+
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Rs/AI/RsAIStats.h"
+#include "Rs/AI/AIController/RsAIControllerBase.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Squad Sight Traces"), STAT_RsSquadSightTraces, STATGROUP_RsAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Squad Sight Traces/Sec"), STAT_RsSquadSightTracesPerSecond, STATGROUP_RsAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Squad Perception Members"), STAT_RsSquadPerceptionMembers, STATGROUP_RsAI);
+
+URsSquadPerceptionSubsystem* URsSquadPerceptionSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsSquadPerceptionSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsSquadPerceptionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsSquadPerceptionSubsystem::RegisterController(ARsAIControllerBase* Controller)
+{
+	if (Controller == nullptr)
+	{
+		return;
+	}
+
+	UnregisterController(Controller);
+
+	FSquad& Squad = Squads.FindOrAdd(GetSquadName(*Controller));
+	FMember& Member = Squad.Members.AddDefaulted_GetRef();
+	Member.Controller = Controller;
+	if (const UBlackboardComponent* BlackboardComponent = Controller->GetBlackboardComponent())
+	{
+		Member.TargetActorKey = BlackboardComponent->GetKeyID(TargetActorKeyName);
+		Member.CanSeeTargetKey = BlackboardComponent->GetKeyID(CanSeeTargetKeyName);
+	}
+
+	// Publishing only writes on target changes, so a member joining a squad that already has a target gets it here.
+	WriteTarget(Member, Squad.CurrentTarget.Get());
+	bTargetsDirty = true;
+	INC_DWORD_STAT(STAT_RsSquadPerceptionMembers);
+}
+
+void URsSquadPerceptionSubsystem::UnregisterController(ARsAIControllerBase* Controller)
+{
+	for (auto It = Squads.CreateIterator(); It; ++It)
+	{
+		const int32 NumRemoved = It->Value.Members.RemoveAllSwap([Controller](const FMember& Member)
+		{
+			return Member.Controller == Controller;
+		});
+		DEC_DWORD_STAT_BY(STAT_RsSquadPerceptionMembers, NumRemoved);
+		bTargetsDirty |= NumRemoved > 0;
+		
+		if (It->Value.Members.IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+AActor* URsSquadPerceptionSubsystem::GetSquadTarget(const ARsAIControllerBase* Controller) const
+{
+	if (Controller)
+	{
+		if (const FSquad* Squad = Squads.Find(GetSquadName(*Controller)))
+		{
+			return Squad->CurrentTarget.Get();
+		}
+	}
+	return nullptr;
+}
+
+void URsSquadPerceptionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TArray<FSquad*> SquadList;
+	for (auto It = Squads.CreateIterator(); It; ++It)
+	{
+		FSquad& Squad = It->Value;
+		const int32 NumRemoved = Squad.Members.RemoveAllSwap([](const FMember& Member)
+		{
+			return !Member.Controller.IsValid() || Member.Controller->GetPawn() == nullptr;
+		});
+		DEC_DWORD_STAT_BY(STAT_RsSquadPerceptionMembers, NumRemoved);
+		bTargetsDirty |= NumRemoved > 0;
+		
+		if (Squad.Members.IsEmpty())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		SquadList.Add(&Squad);
+	}
+
+	if (HavePlayerPawnsChanged() || bTargetsDirty)
+	{
+		SyncAllTargets();
+	}
+
+	// Spend the trace budget on the stalest pairs, visiting squads round-robin.
+	const double Now = GetWorld()->GetTimeSeconds();
+	int32 TraceBudget = MaxTracesPerFrame;
+	for (int32 Count = 0; Count < SquadList.Num() && TraceBudget > 0; ++Count)
+	{
+		NextSquadIndex = NextSquadIndex % SquadList.Num();
+		FSquad& Squad = *SquadList[NextSquadIndex++];
+		for (FSquadTarget& SquadTarget : Squad.Targets)
+		{
+			if (TraceBudget > 0 && Now - SquadTarget.LastCheckTime >= RefreshInterval)
+			{
+				CheckLineOfSight(Squad, SquadTarget);
+				SquadTarget.LastCheckTime = Now;
+				--TraceBudget;
+			}
+		}
+	}
+	
+	for (FSquad* Squad : SquadList)
+	{
+		PublishTarget(*Squad);
+	}
+
+	const int32 NumTraces = MaxTracesPerFrame - TraceBudget;
+	INC_DWORD_STAT_BY(STAT_RsSquadSightTraces, NumTraces);
+	TracesThisSecond += NumTraces;
+	if (Now - TraceCountStartTime >= 1.0)
+	{
+		SET_DWORD_STAT(STAT_RsSquadSightTracesPerSecond, TracesThisSecond);
+		TracesThisSecond = 0;
+		TraceCountStartTime = Now;
+	}
+}
+
+bool URsSquadPerceptionSubsystem::IsTickable() const
+{
+	return !Squads.IsEmpty();
+}
+
+TStatId URsSquadPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsSquadPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+FName URsSquadPerceptionSubsystem::GetSquadName(const ARsAIControllerBase& Controller)
+{
+	if (!Controller.GetSquadName().IsNone())
+	{
+		return Controller.GetSquadName();
+	}
+	// Controllers without an explicit squad share one squad per team.
+	return FName(TEXT("Team"), Controller.GetGenericTeamId().GetId() + 1);
+}
+
+bool URsSquadPerceptionSubsystem::HavePlayerPawnsChanged()
+{
+	TArray<TWeakObjectPtr<APawn>, TInlineAllocator<4>> PlayerPawns;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerPawns.Add(PlayerPawn);
+		}
+	}
+	if (PlayerPawns == LastPlayerPawns)
+	{
+		return false;
+	}
+	LastPlayerPawns = MoveTemp(PlayerPawns);
+	return true;
+}
+
+void URsSquadPerceptionSubsystem::SyncAllTargets()
+{
+	bTargetsDirty = false;
+
+	TArray<AActor*> Candidates;
+	TSet<AActor*> CandidateSet;
+	GatherCandidates(Candidates, CandidateSet);
+	for (TPair<FName, FSquad>& Pair : Squads)
+	{
+		SyncTargets(Pair.Value, Candidates, CandidateSet);
+	}
+}
+
+void URsSquadPerceptionSubsystem::GatherCandidates(TArray<AActor*>& OutCandidates, TSet<AActor*>& OutCandidateSet) const
+{
+	auto AddCandidate = [&OutCandidates, &OutCandidateSet](AActor* Candidate)
+	{
+		bool bAlreadyAdded = false;
+		OutCandidateSet.Add(Candidate, &bAlreadyAdded);
+		if (!bAlreadyAdded)
+		{
+			OutCandidates.Add(Candidate);
+		}
+	};
+
+	for (const TWeakObjectPtr<APawn>& PlayerPawn : LastPlayerPawns)
+	{
+		if (PlayerPawn.IsValid())
+		{
+			AddCandidate(PlayerPawn.Get());
+		}
+	}
+	for (const TPair<FName, FSquad>& Pair : Squads)
+	{
+		for (const FMember& Member : Pair.Value.Members)
+		{
+			if (APawn* Pawn = Member.Controller.IsValid() ? Member.Controller->GetPawn() : nullptr)
+			{
+				AddCandidate(Pawn);
+			}
+		}
+	}
+}
+
+void URsSquadPerceptionSubsystem::SyncTargets(FSquad& Squad, const TArray<AActor*>& Candidates, const TSet<AActor*>& CandidateSet) const
+{
+	// Targets that are still candidates keep their last check, so a sync doesn't queue extra traces.
+	Squad.Targets.RemoveAllSwap([&CandidateSet](const FSquadTarget& SquadTarget)
+	{
+		return !SquadTarget.Target.IsValid() || !CandidateSet.Contains(SquadTarget.Target.Get());
+	});
+	TSet<const AActor*> TrackedTargets;
+	TrackedTargets.Reserve(Squad.Targets.Num());
+	for (const FSquadTarget& SquadTarget : Squad.Targets)
+	{
+		TrackedTargets.Add(SquadTarget.Target.Get());
+	}
+
+	// Same attitude rule as the per-controller perception, evaluated once per squad.
+	const ARsAIControllerBase* Representative = Squad.Members[0].Controller.Get();
+	for (AActor* Candidate : Candidates)
+	{
+		if (!TrackedTargets.Contains(Candidate) && Representative->GetTeamAttitudeTowards(*Candidate) == ETeamAttitude::Hostile)
+		{
+			Squad.Targets.AddDefaulted_GetRef().Target = Candidate;
+		}
+	}
+}
+
+void URsSquadPerceptionSubsystem::CheckLineOfSight(const FSquad& Squad, FSquadTarget& SquadTarget)
+{
+	AActor* Target = SquadTarget.Target.Get();
+	SquadTarget.bVisible = false;
+	SquadTarget.DistanceSquared = UE_BIG_NUMBER;
+	if (Target == nullptr)
+	{
+		return;
+	}
+
+	// Look from the member closest to the target.
+	const FVector TargetLocation = Target->GetActorLocation();
+	const APawn* Viewer = nullptr;
+	for (const FMember& Member : Squad.Members)
+	{
+		if (const APawn* Pawn = Member.Controller.IsValid() ? Member.Controller->GetPawn() : nullptr)
+		{
+			const float DistanceSquared = FVector::DistSquared(Pawn->GetActorLocation(), TargetLocation);
+			if (DistanceSquared < SquadTarget.DistanceSquared)
+			{
+				SquadTarget.DistanceSquared = DistanceSquared;
+				Viewer = Pawn;
+			}
+		}
+	}
+	if (Viewer == nullptr || SquadTarget.DistanceSquared > FMath::Square(SightRadius))
+	{
+		return;
+	}
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RsSquadSight), false, Viewer);
+	QueryParams.AddIgnoredActor(Target);
+	SquadTarget.bVisible = !GetWorld()->LineTraceTestByChannel(Viewer->GetPawnViewLocation(), TargetLocation, SightTraceChannel, QueryParams);
+}
+
+void URsSquadPerceptionSubsystem::PublishTarget(FSquad& Squad) const
+{
+	AActor* BestTarget = nullptr;
+	float BestDistanceSquared = UE_BIG_NUMBER;
+	for (const FSquadTarget& SquadTarget : Squad.Targets)
+	{
+		if (SquadTarget.bVisible && SquadTarget.DistanceSquared < BestDistanceSquared)
+		{
+			BestTarget = SquadTarget.Target.Get();
+			BestDistanceSquared = SquadTarget.DistanceSquared;
+		}
+	}
+	
+	if (Squad.CurrentTarget == BestTarget)
+	{
+		return;
+	}
+	
+	Squad.CurrentTarget = BestTarget;
+	for (const FMember& Member : Squad.Members)
+	{
+		WriteTarget(Member, BestTarget);
+	}
+}
+
+void URsSquadPerceptionSubsystem::WriteTarget(const FMember& Member, AActor* Target)
+{
+	UBlackboardComponent* BlackboardComponent = Member.Controller.IsValid() ? Member.Controller->GetBlackboardComponent() : nullptr;
+	if (BlackboardComponent == nullptr)
+	{
+		return;
+	}
+	if (Member.TargetActorKey != FBlackboard::InvalidKey)
+	{
+		BlackboardComponent->SetValue<UBlackboardKeyType_Object>(Member.TargetActorKey, Target);
+	}
+	if (Member.CanSeeTargetKey != FBlackboard::InvalidKey)
+	{
+		BlackboardComponent->SetValue<UBlackboardKeyType_Bool>(Member.CanSeeTargetKey, Target != nullptr);
+	}
+}
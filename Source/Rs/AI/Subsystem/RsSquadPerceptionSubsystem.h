@@ -0,0 +1,102 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsSquadPerceptionSubsystem.generated.h"
+
+class ARsAIControllerBase;
+
+/**
+ * Shared sight for AI squads. Line of sight is checked once per (squad, hostile target) pair at a budgeted rate, instead of once per controller.
+ * Each squad's nearest visible target is published to its members' blackboards.
+ * Controllers opt in with bUseSquadPerception, which also disables their own perception senses.
+ */
+UCLASS(Config = Game)
+class RS_API URsSquadPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsSquadPerceptionSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void RegisterController(ARsAIControllerBase* Controller);
+	void UnregisterController(ARsAIControllerBase* Controller);
+
+	AActor* GetSquadTarget(const ARsAIControllerBase* Controller) const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FMember
+	{
+		TWeakObjectPtr<ARsAIControllerBase> Controller;
+		FBlackboard::FKey TargetActorKey = FBlackboard::InvalidKey;
+		FBlackboard::FKey CanSeeTargetKey = FBlackboard::InvalidKey;
+	};
+
+	struct FSquadTarget
+	{
+		TWeakObjectPtr<AActor> Target;
+		double LastCheckTime = -UE_DOUBLE_BIG_NUMBER;
+		float DistanceSquared = UE_BIG_NUMBER;
+		bool bVisible = false;
+	};
+
+	struct FSquad
+	{
+		TArray<FMember> Members;
+		TArray<FSquadTarget> Targets;
+		TWeakObjectPtr<AActor> CurrentTarget;
+	};
+
+	static FName GetSquadName(const ARsAIControllerBase& Controller);
+
+	// Rebuilds every squad's target list. Only runs when squad membership or the player pawns have changed.
+	void SyncAllTargets();
+	void GatherCandidates(TArray<AActor*>& OutCandidates, TSet<AActor*>& OutCandidateSet) const;
+	void SyncTargets(FSquad& Squad, const TArray<AActor*>& Candidates, const TSet<AActor*>& CandidateSet) const;
+	bool HavePlayerPawnsChanged();
+	void CheckLineOfSight(const FSquad& Squad, FSquadTarget& SquadTarget);
+	void PublishTarget(FSquad& Squad) const;
+	static void WriteTarget(const FMember& Member, AActor* Target);
+
+	// Publish keys. Members whose blackboard lacks a key just skip it.
+	UPROPERTY(Config)
+	FName TargetActorKeyName = TEXT("TargetActor");
+
+	UPROPERTY(Config)
+	FName CanSeeTargetKeyName = TEXT("bCanSeeTarget");
+
+	UPROPERTY(Config)
+	float SightRadius = 3000.f;
+
+	// Minimum time between two checks of the same (squad, target) pair.
+	UPROPERTY(Config)
+	float RefreshInterval = 0.2f;
+
+	UPROPERTY(Config)
+	int32 MaxTracesPerFrame = 16;
+
+	UPROPERTY(Config)
+	TEnumAsByte<ECollisionChannel> SightTraceChannel = ECC_Visibility;
+
+	TMap<FName, FSquad> Squads;
+
+	// Player pawns at the last target sync. Possession changes show up here.
+	TArray<TWeakObjectPtr<APawn>, TInlineAllocator<4>> LastPlayerPawns;
+	bool bTargetsDirty = true;
+
+	// Round-robin cursor, so that a busy squad can't starve the others.
+	int32 NextSquadIndex = 0;
+
+	int32 TracesThisSecond = 0;
+	double TraceCountStartTime = 0.0;
+};
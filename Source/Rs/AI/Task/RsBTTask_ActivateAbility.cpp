@@ -0,0 +1,268 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsBTTask_ActivateAbility.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Rs/AbilitySystem/Component/RsAbilitySystemComponent.h"
+#include "Rs/AI/Subsystem/RsAttackTokenSubsystem.h"
+
+URsBTTask_ActivateAbility::URsBTTask_ActivateAbility()
+{
+	NodeName = TEXT("RS Activate Ability");
+	bNotifyTaskFinished = true;
+	bCreateNodeInstance = false;
+
+	ActivationFailedKey.AddBoolFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, ActivationFailedKey));
+	ActivationFailedKey.AllowNoneAsValue(true);
+	AttackTargetKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, AttackTargetKey), AActor::StaticClass());
+}
+
+void URsBTTask_ActivateAbility::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* BlackboardAsset = GetBlackboardAsset())
+	{
+		ActivationFailedKey.ResolveSelectedKey(*BlackboardAsset);
+		AttackTargetKey.ResolveSelectedKey(*BlackboardAsset);
+	}
+}
+
+EBTNodeResult::Type URsBTTask_ActivateAbility::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FRsBTActivateAbilityMemory* Memory = CastInstanceNodeMemory<FRsBTActivateAbilityMemory>(NodeMemory);
+	
+	const AAIController* AIController = OwnerComp.GetAIOwner();
+	UAbilitySystemComponent* AbilitySystemComponent = AIController ? UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(AIController->GetPawn()) : nullptr;
+	if (AbilitySystemComponent == nullptr)
+	{
+		SetActivationFailed(OwnerComp, true);
+		return EBTNodeResult::Failed;
+	}
+
+	FGameplayAbilitySpecHandle AbilitySpecHandle;
+	if (const URsAbilitySystemComponent* RsASC = Cast<URsAbilitySystemComponent>(AbilitySystemComponent))
+	{
+		AbilitySpecHandle = RsASC->FindAbilitySpecHandleWithTag(AbilityTag, bExactMatch);
+	}
+	else
+	{
+		TArray<FGameplayAbilitySpecHandle> FoundHandles;
+		AbilitySystemComponent->FindAllAbilitiesWithTags(FoundHandles, FGameplayTagContainer(AbilityTag), bExactMatch);
+		if (!FoundHandles.IsEmpty())
+		{
+			AbilitySpecHandle = FoundHandles[0];
+		}
+	}
+	
+	if (!AbilitySpecHandle.IsValid())
+	{
+		SetActivationFailed(OwnerComp, true);
+		return EBTNodeResult::Failed;
+	}
+
+	Memory->AbilitySystemComponent = AbilitySystemComponent;
+	Memory->AbilitySpecHandle = AbilitySpecHandle;
+	Memory->bWaitingForAttackToken = false;
+
+	if (bRequireAttackToken)
+	{
+		const UBlackboardComponent* BlackboardComponent = OwnerComp.GetBlackboardComponent();
+		AActor* AttackTarget = BlackboardComponent ? Cast<AActor>(BlackboardComponent->GetValue<UBlackboardKeyType_Object>(AttackTargetKey.GetSelectedKeyID())) : nullptr;
+		URsAttackTokenSubsystem* AttackTokenSubsystem = URsAttackTokenSubsystem::Get(AIController);
+		if (AttackTarget == nullptr || AttackTokenSubsystem == nullptr)
+		{
+			SetActivationFailed(OwnerComp, true);
+			return EBTNodeResult::Failed;
+		}
+
+		const FSimpleDelegate OnGranted = FSimpleDelegate::CreateUObject(this, &ThisClass::HandleAttackTokenGranted, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp), Memory);
+		if (!AttackTokenSubsystem->RequestToken(AIController->GetPawn(), AttackTarget, OnGranted))
+		{
+			Memory->bWaitingForAttackToken = true;
+			return EBTNodeResult::InProgress;
+		}
+	}
+
+	return ActivateAbility(OwnerComp, *Memory);
+}
+
+EBTNodeResult::Type URsBTTask_ActivateAbility::ActivateAbility(UBehaviorTreeComponent& OwnerComp, FRsBTActivateAbilityMemory& Memory)
+{
+	UAbilitySystemComponent* AbilitySystemComponent = Memory.AbilitySystemComponent.Get();
+	if (AbilitySystemComponent == nullptr)
+	{
+		SetActivationFailed(OwnerComp, true);
+		return EBTNodeResult::Failed;
+	}
+	
+	Memory.bActivating = true;
+	Memory.bEndedWhileActivating = false;
+	Memory.bWasCancelled = false;
+	
+	// Bind before activation, because abilities can end during activation.
+	if (bWaitForAbilityEnd)
+	{
+		Memory.AbilityEndedDelegateHandle = AbilitySystemComponent->OnAbilityEnded.AddUObject(this, &ThisClass::HandleAbilityEnded, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp), &Memory);
+	}
+	
+	const bool bActivated = AbilitySystemComponent->TryActivateAbility(Memory.AbilitySpecHandle);
+	Memory.bActivating = false;
+	SetActivationFailed(OwnerComp, !bActivated);
+	
+	if (!bActivated)
+	{
+		UnbindAbilityEnded(Memory);
+		return EBTNodeResult::Failed;
+	}
+	
+	if (!bWaitForAbilityEnd)
+	{
+		return EBTNodeResult::Succeeded;
+	}
+	
+	if (Memory.bEndedWhileActivating)
+	{
+		UnbindAbilityEnded(Memory);
+		return Memory.bWasCancelled ? EBTNodeResult::Failed : EBTNodeResult::Succeeded;
+	}
+	
+	return EBTNodeResult::InProgress;
+}
+
+EBTNodeResult::Type URsBTTask_ActivateAbility::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FRsBTActivateAbilityMemory* Memory = CastInstanceNodeMemory<FRsBTActivateAbilityMemory>(NodeMemory);
+	
+	// Unbind first, so cancelling doesn't finish the task again.
+	UnbindAbilityEnded(*Memory);
+	CancelAttackToken(*Memory, true);
+	if (UAbilitySystemComponent* AbilitySystemComponent = Memory->AbilitySystemComponent.Get())
+	{
+		AbilitySystemComponent->CancelAbilityHandle(Memory->AbilitySpecHandle);
+	}
+	
+	return EBTNodeResult::Aborted;
+}
+
+void URsBTTask_ActivateAbility::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	FRsBTActivateAbilityMemory* Memory = CastInstanceNodeMemory<FRsBTActivateAbilityMemory>(NodeMemory);
+	UnbindAbilityEnded(*Memory);
+	
+	// Without waiting, a successfully activated ability keeps the token until it ends.
+	CancelAttackToken(*Memory, bWaitForAbilityEnd || TaskResult != EBTNodeResult::Succeeded);
+	
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+uint16 URsBTTask_ActivateAbility::GetInstanceMemorySize() const
+{
+	return sizeof(FRsBTActivateAbilityMemory);
+}
+
+void URsBTTask_ActivateAbility::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FRsBTActivateAbilityMemory>(NodeMemory, InitType);
+}
+
+void URsBTTask_ActivateAbility::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	FRsBTActivateAbilityMemory* Memory = CastInstanceNodeMemory<FRsBTActivateAbilityMemory>(NodeMemory);
+	UnbindAbilityEnded(*Memory);
+	CancelAttackToken(*Memory, false);
+	CleanupNodeMemory<FRsBTActivateAbilityMemory>(NodeMemory, CleanupType);
+}
+
+FString URsBTTask_ActivateAbility::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s%s%s"), *Super::GetStaticDescription(), *AbilityTag.ToString(), bWaitForAbilityEnd ? TEXT(" (wait for end)") : TEXT(""), bRequireAttackToken ? TEXT(" (attack token)") : TEXT(""));
+}
+
+void URsBTTask_ActivateAbility::HandleAbilityEnded(const FAbilityEndedData& AbilityEndedData, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, FRsBTActivateAbilityMemory* Memory)
+{
+	if (AbilityEndedData.AbilitySpecHandle != Memory->AbilitySpecHandle)
+	{
+		return;
+	}
+
+	if (Memory->bActivating)
+	{
+		Memory->bEndedWhileActivating = true;
+		Memory->bWasCancelled = AbilityEndedData.bWasCancelled;
+		return;
+	}
+
+	if (UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get())
+	{
+		FinishLatentTask(*OwnerComp, AbilityEndedData.bWasCancelled ? EBTNodeResult::Failed : EBTNodeResult::Succeeded);
+	}
+}
+
+void URsBTTask_ActivateAbility::SetActivationFailed(UBehaviorTreeComponent& OwnerComp, bool bFailed) const
+{
+	if (ActivationFailedKey.IsSet())
+	{
+		if (UBlackboardComponent* BlackboardComponent = OwnerComp.GetBlackboardComponent())
+		{
+			BlackboardComponent->SetValue<UBlackboardKeyType_Bool>(ActivationFailedKey.GetSelectedKeyID(), bFailed);
+		}
+	}
+}
+
+void URsBTTask_ActivateAbility::UnbindAbilityEnded(FRsBTActivateAbilityMemory& Memory) const
+{
+	if (UAbilitySystemComponent* AbilitySystemComponent = Memory.AbilitySystemComponent.Get())
+	{
+		AbilitySystemComponent->OnAbilityEnded.Remove(Memory.AbilityEndedDelegateHandle);
+	}
+	Memory.AbilityEndedDelegateHandle.Reset();
+}
+
+void URsBTTask_ActivateAbility::HandleAttackTokenGranted(TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, FRsBTActivateAbilityMemory* Memory)
+{
+	UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get();
+	if (OwnerComp == nullptr || !Memory->bWaitingForAttackToken)
+	{
+		return;
+	}
+
+	Memory->bWaitingForAttackToken = false;
+	const EBTNodeResult::Type Result = ActivateAbility(*OwnerComp, *Memory);
+	if (Result != EBTNodeResult::InProgress)
+	{
+		FinishLatentTask(*OwnerComp, Result);
+	}
+}
+
+void URsBTTask_ActivateAbility::CancelAttackToken(FRsBTActivateAbilityMemory& Memory, bool bRelease) const
+{
+	if (!bRequireAttackToken)
+	{
+		return;
+	}
+
+	const UAbilitySystemComponent* AbilitySystemComponent = Memory.AbilitySystemComponent.Get();
+	const AActor* Attacker = AbilitySystemComponent ? AbilitySystemComponent->GetAvatarActor() : nullptr;
+	URsAttackTokenSubsystem* AttackTokenSubsystem = Attacker ? URsAttackTokenSubsystem::Get(Attacker) : nullptr;
+	if (AttackTokenSubsystem == nullptr)
+	{
+		return;
+	}
+
+	if (Memory.bWaitingForAttackToken)
+	{
+		AttackTokenSubsystem->CancelRequest(Attacker);
+		Memory.bWaitingForAttackToken = false;
+	}
+	else if (bRelease)
+	{
+		AttackTokenSubsystem->ReleaseToken(Attacker);
+	}
+}
@@ -0,0 +1,76 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayAbilitySpecHandle.h"
+#include "GameplayTagContainer.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "RsBTTask_ActivateAbility.generated.h"
+
+class UAbilitySystemComponent;
+struct FAbilityEndedData;
+
+struct FRsBTActivateAbilityMemory
+{
+	TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+	FGameplayAbilitySpecHandle AbilitySpecHandle;
+	FDelegateHandle AbilityEndedDelegateHandle;
+	bool bActivating = false;
+	bool bWaitingForAttackToken = false;
+	bool bEndedWhileActivating = false;
+	bool bWasCancelled = false;
+};
+
+/**
+ * Activates the pawn's ability that has "Ability Tag", and optionally waits until it ends.
+ * Ability lookup goes through the ability system component's tag index, and the wait is driven by the ability ended event instead of ticking.
+ * With "Require Attack Token", activation waits until the attack token subsystem grants a token for the target.
+ */
+UCLASS(meta = (DisplayName = "RS Activate Ability"))
+class RS_API URsBTTask_ActivateAbility : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	URsBTTask_ActivateAbility();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	UPROPERTY(EditAnywhere, Category = "RS", meta = (Categories = "Ability"))
+	FGameplayTag AbilityTag;
+
+	UPROPERTY(EditAnywhere, Category = "RS")
+	bool bExactMatch = true;
+
+	// Finish the task when the ability ends. Otherwise the task succeeds as soon as the ability is activated.
+	UPROPERTY(EditAnywhere, Category = "RS")
+	bool bWaitForAbilityEnd = true;
+
+	// Optional bool key. Set to true when the ability can't be found or activated, and false when it is activated.
+	UPROPERTY(EditAnywhere, Category = "RS")
+	FBlackboardKeySelector ActivationFailedKey;
+
+	// Wait for an attack token for the target before activating, to bound how many attackers hit the same target at once.
+	UPROPERTY(EditAnywhere, Category = "RS|Attack Token")
+	bool bRequireAttackToken = false;
+
+	UPROPERTY(EditAnywhere, Category = "RS|Attack Token", meta = (EditCondition = "bRequireAttackToken"))
+	FBlackboardKeySelector AttackTargetKey;
+
+private:
+	EBTNodeResult::Type ActivateAbility(UBehaviorTreeComponent& OwnerComp, FRsBTActivateAbilityMemory& Memory);
+	void HandleAttackTokenGranted(TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, FRsBTActivateAbilityMemory* Memory);
+	void CancelAttackToken(FRsBTActivateAbilityMemory& Memory, bool bRelease) const;
+	void HandleAbilityEnded(const FAbilityEndedData& AbilityEndedData, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, FRsBTActivateAbilityMemory* Memory);
+	void SetActivationFailed(UBehaviorTreeComponent& OwnerComp, bool bFailed) const;
+	void UnbindAbilityEnded(FRsBTActivateAbilityMemory& Memory) const;
+};
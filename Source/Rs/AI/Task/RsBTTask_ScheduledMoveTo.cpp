@@ -0,0 +1,196 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsBTTask_ScheduledMoveTo.h"
+
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Rs/AI/Subsystem/RsPathRequestSubsystem.h"
+
+URsBTTask_ScheduledMoveTo::URsBTTask_ScheduledMoveTo()
+{
+	NodeName = TEXT("RS Scheduled Move To");
+	bNotifyTaskFinished = true;
+	bCreateNodeInstance = false;
+
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, BlackboardKey), AActor::StaticClass());
+	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, BlackboardKey));
+}
+
+EBTNodeResult::Type URsBTTask_ScheduledMoveTo::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FRsBTScheduledMoveToMemory* Memory = CastInstanceNodeMemory<FRsBTScheduledMoveToMemory>(NodeMemory);
+	
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	URsPathRequestSubsystem* PathRequestSubsystem = URsPathRequestSubsystem::Get(AIController);
+	AActor* GoalActor = nullptr;
+	FVector GoalLocation;
+	if (AIController == nullptr || PathRequestSubsystem == nullptr || !GetGoal(OwnerComp, GoalActor, GoalLocation))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FNavPathSharedPtr CachedPath;
+	if (PathRequestSubsystem->TryGetCachedPath(AIController, GoalLocation, CachedPath))
+	{
+		return StartMove(OwnerComp, *Memory, CachedPath);
+	}
+
+	Memory->PathRequestSubsystem = PathRequestSubsystem;
+	Memory->PathRequestID = PathRequestSubsystem->RequestPath(AIController, GoalLocation, FRsPathReadyDelegate::CreateUObject(this, &ThisClass::HandlePathReady, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp), Memory));
+	return Memory->PathRequestID != 0 ? EBTNodeResult::InProgress : EBTNodeResult::Failed;
+}
+
+EBTNodeResult::Type URsBTTask_ScheduledMoveTo::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	StopPendingWork(*CastInstanceNodeMemory<FRsBTScheduledMoveToMemory>(NodeMemory), true);
+	return EBTNodeResult::Aborted;
+}
+
+void URsBTTask_ScheduledMoveTo::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	StopPendingWork(*CastInstanceNodeMemory<FRsBTScheduledMoveToMemory>(NodeMemory), false);
+	
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+uint16 URsBTTask_ScheduledMoveTo::GetInstanceMemorySize() const
+{
+	return sizeof(FRsBTScheduledMoveToMemory);
+}
+
+void URsBTTask_ScheduledMoveTo::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FRsBTScheduledMoveToMemory>(NodeMemory, InitType);
+}
+
+void URsBTTask_ScheduledMoveTo::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	StopPendingWork(*CastInstanceNodeMemory<FRsBTScheduledMoveToMemory>(NodeMemory), false);
+	CleanupNodeMemory<FRsBTScheduledMoveToMemory>(NodeMemory, CleanupType);
+}
+
+FString URsBTTask_ScheduledMoveTo::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s (%.0f)"), *Super::GetStaticDescription(), *GetSelectedBlackboardKey().ToString(), AcceptableRadius);
+}
+
+EBTNodeResult::Type URsBTTask_ScheduledMoveTo::StartMove(UBehaviorTreeComponent& OwnerComp, FRsBTScheduledMoveToMemory& Memory, FNavPathSharedPtr Path)
+{
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	UPathFollowingComponent* PathFollowingComponent = AIController ? AIController->GetPathFollowingComponent() : nullptr;
+	AActor* GoalActor = nullptr;
+	FVector GoalLocation;
+	if (PathFollowingComponent == nullptr || !Path.IsValid() || !GetGoal(OwnerComp, GoalActor, GoalLocation))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FAIMoveRequest MoveRequest;
+	if (GoalActor)
+	{
+		MoveRequest.SetGoalActor(GoalActor);
+	}
+	else
+	{
+		MoveRequest.SetGoalLocation(GoalLocation);
+	}
+	MoveRequest.SetAcceptanceRadius(AcceptableRadius);
+
+	const FAIRequestID MoveRequestID = AIController->RequestMove(MoveRequest, Path);
+	if (!MoveRequestID.IsValid())
+	{
+		return EBTNodeResult::Failed;
+	}
+	
+	// The move can finish inside RequestMove. (e.g. already at goal)
+	if (PathFollowingComponent->GetCurrentRequestId() != MoveRequestID || PathFollowingComponent->GetStatus() == EPathFollowingStatus::Idle)
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	Memory.MoveRequestID = MoveRequestID;
+	Memory.PathFollowingComponent = PathFollowingComponent;
+	Memory.MoveFinishedDelegateHandle = PathFollowingComponent->OnRequestFinished.AddUObject(this, &ThisClass::HandleMoveFinished, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp), &Memory);
+	return EBTNodeResult::InProgress;
+}
+
+void URsBTTask_ScheduledMoveTo::HandlePathReady(FNavPathSharedPtr Path, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, FRsBTScheduledMoveToMemory* Memory)
+{
+	UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get();
+	if (OwnerComp == nullptr || Memory->PathRequestID == 0)
+	{
+		return;
+	}
+
+	Memory->PathRequestID = 0;
+	const EBTNodeResult::Type Result = StartMove(*OwnerComp, *Memory, Path);
+	if (Result != EBTNodeResult::InProgress)
+	{
+		FinishLatentTask(*OwnerComp, Result);
+	}
+}
+
+void URsBTTask_ScheduledMoveTo::HandleMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, FRsBTScheduledMoveToMemory* Memory)
+{
+	if (RequestID != Memory->MoveRequestID)
+	{
+		return;
+	}
+
+	StopPendingWork(*Memory, false);
+	if (UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get())
+	{
+		FinishLatentTask(*OwnerComp, Result.IsSuccess() ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+	}
+}
+
+void URsBTTask_ScheduledMoveTo::StopPendingWork(FRsBTScheduledMoveToMemory& Memory, bool bAbortMove) const
+{
+	if (Memory.PathRequestID != 0)
+	{
+		if (URsPathRequestSubsystem* PathRequestSubsystem = Memory.PathRequestSubsystem.Get())
+		{
+			PathRequestSubsystem->CancelRequest(Memory.PathRequestID);
+		}
+		Memory.PathRequestID = 0;
+	}
+
+	if (UPathFollowingComponent* PathFollowingComponent = Memory.PathFollowingComponent.Get())
+	{
+		PathFollowingComponent->OnRequestFinished.Remove(Memory.MoveFinishedDelegateHandle);
+		if (bAbortMove && PathFollowingComponent->GetCurrentRequestId() == Memory.MoveRequestID)
+		{
+			PathFollowingComponent->AbortMove(*this, FPathFollowingResultFlags::OwnerFinished, Memory.MoveRequestID);
+		}
+	}
+	Memory.PathFollowingComponent.Reset();
+	Memory.MoveFinishedDelegateHandle.Reset();
+	Memory.MoveRequestID = FAIRequestID::InvalidRequest;
+}
+
+bool URsBTTask_ScheduledMoveTo::GetGoal(const UBehaviorTreeComponent& OwnerComp, AActor*& OutGoalActor, FVector& OutGoalLocation) const
+{
+	const UBlackboardComponent* BlackboardComponent = OwnerComp.GetBlackboardComponent();
+	if (BlackboardComponent == nullptr)
+	{
+		return false;
+	}
+
+	if (BlackboardKey.SelectedKeyType == UBlackboardKeyType_Object::StaticClass())
+	{
+		OutGoalActor = Cast<AActor>(BlackboardComponent->GetValue<UBlackboardKeyType_Object>(BlackboardKey.GetSelectedKeyID()));
+		if (OutGoalActor)
+		{
+			OutGoalLocation = OutGoalActor->GetActorLocation();
+			return true;
+		}
+		return false;
+	}
+	
+	OutGoalLocation = BlackboardComponent->GetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID());
+	return FAISystem::IsValidLocation(OutGoalLocation);
+}
@@ -0,0 +1,54 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AITypes.h"
+#include "NavigationData.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "RsBTTask_ScheduledMoveTo.generated.h"
+
+class UPathFollowingComponent;
+class URsPathRequestSubsystem;
+struct FPathFollowingResult;
+
+struct FRsBTScheduledMoveToMemory
+{
+	TWeakObjectPtr<URsPathRequestSubsystem> PathRequestSubsystem;
+	uint32 PathRequestID = 0;
+	FAIRequestID MoveRequestID;
+	TWeakObjectPtr<UPathFollowingComponent> PathFollowingComponent;
+	FDelegateHandle MoveFinishedDelegateHandle;
+};
+
+/**
+ * Moves to the blackboard actor or location, with the path from the path request subsystem instead of a synchronous query.
+ * Agents of a squad chasing the same target share one query and its corridor.
+ */
+UCLASS(meta = (DisplayName = "RS Scheduled Move To"))
+class RS_API URsBTTask_ScheduledMoveTo : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	URsBTTask_ScheduledMoveTo();
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	UPROPERTY(EditAnywhere, Category = "RS", meta = (ClampMin = "0.0"))
+	float AcceptableRadius = 50.f;
+
+private:
+	EBTNodeResult::Type StartMove(UBehaviorTreeComponent& OwnerComp, FRsBTScheduledMoveToMemory& Memory, FNavPathSharedPtr Path);
+	void HandlePathReady(FNavPathSharedPtr Path, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, FRsBTScheduledMoveToMemory* Memory);
+	void HandleMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp, FRsBTScheduledMoveToMemory* Memory);
+	void StopPendingWork(FRsBTScheduledMoveToMemory& Memory, bool bAbortMove) const;
+	bool GetGoal(const UBehaviorTreeComponent& OwnerComp, AActor*& OutGoalActor, FVector& OutGoalLocation) const;
+};
@@ -39,6 +39,12 @@ void URsGameplayAbility::OnAvatarSet(const FGameplayAbilityActorInfo* ActorInfo,
 {
 	Super::OnAvatarSet(ActorInfo, Spec);
 
+	// Instanced Per Execution abilities receive this on the CDO, which is shared by every actor. They are set up in ActivateAbility instead.
+	if (!IsInstantiated())
+	{
+		return;
+	}
+	
 	// Set the "Avatar Character" reference.
 	AvatarCharacter = Cast<ARsCharacterBase>(ActorInfo->AvatarActor);
 	
@@ -68,10 +74,34 @@ void URsGameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle
 {
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
+	// Instanced Per Execution abilities are created on activation, so OnAvatarSet was never called on this instance.
+	if (GetInstancingPolicy() == EGameplayAbilityInstancingPolicy::InstancedPerExecution)
+	{
+		AvatarCharacter = Cast<ARsCharacterBase>(ActorInfo->AvatarActor);
+		
+		if (URsAbilitySystemComponent* RsASC = Cast<URsAbilitySystemComponent>(ActorInfo->AbilitySystemComponent))
+		{
+			RsASC->OnAnyGameplayEvent.AddUObject(this, &ThisClass::HandleGameplayEvent);
+		}
+	}
+	
 	// Apply cooldowns and costs
 	CommitAbility(Handle, ActorInfo, ActivationInfo);
 }
 
+void URsGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+	if (GetInstancingPolicy() == EGameplayAbilityInstancingPolicy::InstancedPerExecution)
+	{
+		if (URsAbilitySystemComponent* RsASC = Cast<URsAbilitySystemComponent>(ActorInfo->AbilitySystemComponent))
+		{
+			RsASC->OnAnyGameplayEvent.RemoveAll(this);
+		}
+	}
+	
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
 void URsGameplayAbility::SetupEnhancedInputBindings(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
 {
 	// Check to see if the "Activation Input Action" is valid.
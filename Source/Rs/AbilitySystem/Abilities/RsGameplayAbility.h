@@ -9,7 +9,9 @@
 
 class ARsCharacterBase;
 /**
- * 
+ * Defaults to Instanced Per Actor.
+ * Simple abilities that are granted to many actors (e.g. enemy attacks, hit reactions) can set Instancing Policy to Instanced Per Execution,
+ * so that an instance only exists while the ability is active. Those abilities must not keep state between activations.
  */
 UCLASS()
 class RS_API URsGameplayAbility : public UGameplayAbility
@@ -55,6 +57,7 @@ protected:
 	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
 
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 
 	// Called to bind Input Pressed and Input Released events to the Avatar Actor's Enhanced Input Component if it is reachable. 
 	void SetupEnhancedInputBindings(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec);
@@ -6,6 +6,7 @@
 #include "AbilitySystemComponent.h"
 #include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
 #include "Abilities/Tasks/AbilityTask_WaitInputPress.h"
+#include "Rs/Battle/RsCombatStats.h"
 
 URsGameplayAbility_Combo::URsGameplayAbility_Combo()
 {
@@ -14,6 +15,12 @@ URsGameplayAbility_Combo::URsGameplayAbility_Combo()
 void URsGameplayAbility_Combo::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
 {
 	Super::OnGiveAbility(ActorInfo, Spec);
+
+	// Inner ability handles and combo index live in the instance, so combo abilities must be Instanced Per Actor.
+	if (!ensureMsgf(IsInstantiated(), TEXT("RsGameplayAbility_Combo::OnGiveAbility: %s must be Instanced Per Actor"), *GetName()))
+	{
+		return;
+	}
 	
 	for (TSubclassOf<URsGameplayAbility> InnerAbility : InnerAbilities)
 	{
@@ -72,6 +79,8 @@ void URsGameplayAbility_Combo::OnRemoveAbility(const FGameplayAbilityActorInfo*
 
 void URsGameplayAbility_Combo::ActivateInnerAbility()
 {
+	RS_COMBAT_SCOPE(RsGameplayAbility_Combo_ActivateInnerAbility);
+
 	if (GetAbilitySystemComponentFromActorInfo()->TryActivateAbility(InnerHandles[CurrentComboIndex]))
 	{
 		IncrementComboIndex();
@@ -135,6 +144,8 @@ void URsGameplayAbility_Combo::HandleInnerAbilityActivated(UGameplayAbility* Act
 
 void URsGameplayAbility_Combo::HandleInnerAbilityEnded(const FAbilityEndedData& AbilityEndData)
 {
+	RS_COMBAT_SCOPE(RsGameplayAbility_Combo_HandleInnerAbilityEnded);
+
 	if (InnerHandles.Contains(AbilityEndData.AbilitySpecHandle))
 	{
 		InnerHandlesActivating.Remove(AbilityEndData.AbilitySpecHandle);
@@ -6,6 +6,9 @@
 #include "AbilitySystemComponent.h"
 #include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
 #include "Rs/AbilitySystem/AbilityTask/RsAbilityTask_TurnToLocation.h"
+#include "Rs/AbilitySystem/Attributes/RsAttackSet.h"
+#include "Rs/AI/RsAILibrary.h"
+#include "Rs/AI/Subsystem/RsCrowdSubsystem.h"
 #include "Rs/Battle/RsBattleLibrary.h"
 
 void URsGameplayAbility_Melee::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
@@ -15,43 +18,74 @@ void URsGameplayAbility_Melee::ActivateAbility(const FGameplayAbilitySpecHandle
 	if (FocusTargetingPreset)
 	{
 		TArray<AActor*> Victims;
-		if (URsBattleLibrary::ExecuteTargeting(GetAvatarActorFromActorInfo(), FocusTargetingPreset, Victims))
+		if (URsBattleLibrary::ExecuteLagCompensatedTargeting(GetAvatarActorFromActorInfo(), FocusTargetingPreset, Victims))
 		{
 			URsAbilityTask_TurnToLocation* TurnTask = URsAbilityTask_TurnToLocation::TurnToLocation(this, Victims[0]->GetActorLocation(), RotatingSpeed, RotatingMaxDuration);
 			TurnTask->ReadyForActivation();
 		}
 	}
 	
-	if (DamageTargetingPreset)
+	if (HitDetectEventTag.IsValid())
 	{
-		if (HitDetectEventTag.IsValid())
-		{
-			UAbilityTask_WaitGameplayEvent* HitDetectTask = UAbilityTask_WaitGameplayEvent::WaitGameplayEvent(this, HitDetectEventTag);
-			HitDetectTask->EventReceived.AddDynamic(this, &ThisClass::HandleHitDetect);
-			HitDetectTask->ReadyForActivation();
-		}
-		else
-		{
-			// Deal damage immediately if Event tag is not set.
-			HandleHitDetect(FGameplayEventData());
-		}
+		// Hit detect events come from AN_HitDetect (targeting preset) or from weapon trace notify states (one event per victim).
+		UAbilityTask_WaitGameplayEvent* HitDetectTask = UAbilityTask_WaitGameplayEvent::WaitGameplayEvent(this, HitDetectEventTag);
+		HitDetectTask->EventReceived.AddDynamic(this, &ThisClass::HandleHitDetect);
+		HitDetectTask->ReadyForActivation();
+	}
+	else if (DamageTargetingPreset)
+	{
+		// Deal damage immediately if Event tag is not set.
+		HandleHitDetect(FGameplayEventData());
 	}
 }
 
 void URsGameplayAbility_Melee::HandleHitDetect(FGameplayEventData EventData)
 {
+	// Weapon trace already found the victim.
+	AActor* TracedVictim = const_cast<AActor*>(EventData.Target.Get());
+	if (TracedVictim && TracedVictim != GetAvatarActorFromActorInfo())
+	{
+		ApplyDamageToVictim(TracedVictim);
+		return;
+	}
+	
 	TArray<AActor*> Victims;
-	if (URsBattleLibrary::ExecuteTargeting(GetAvatarActorFromActorInfo(), DamageTargetingPreset, Victims))
+	if (URsBattleLibrary::ExecuteLagCompensatedTargeting(GetAvatarActorFromActorInfo(), DamageTargetingPreset, Victims))
 	{
 		for (AActor* Victim : Victims)
 		{
-			FGameplayEffectSpecHandle DamageEffectSpecHandle = MakeOutgoingGameplayEffectSpec(DamageEffectClass, GetAbilityLevel());
-			if (DamageEffectSpecHandle.IsValid())
-			{
-				DamageEffectSpecHandle.Data->SetSetByCallerMagnitude(FName("DamageCoefficient"), DamageCoefficient);
-				DamageEffectSpecHandle.Data->SetSetByCallerMagnitude(FName("StaggerCoefficient"), StaggerCoefficient);
-				URsBattleLibrary::ApplyDamageEffectSpec(GetAvatarActorFromActorInfo(), Victim, DamageEffectSpecHandle);
-			}
+			ApplyDamageToVictim(Victim);
 		}
 	}
+
+	if (CrowdDamageRadius > 0.f && HasAuthority(&CurrentActivationInfo))
+	{
+		ApplyDamageToCrowd();
+	}
+}
+
+void URsGameplayAbility_Melee::ApplyDamageToVictim(AActor* Victim)
+{
+	FGameplayEffectSpecHandle DamageEffectSpecHandle = MakeOutgoingGameplayEffectSpec(DamageEffectClass, GetAbilityLevel());
+	if (DamageEffectSpecHandle.IsValid())
+	{
+		DamageEffectSpecHandle.Data->SetSetByCallerMagnitude(FName("DamageCoefficient"), DamageCoefficient);
+		DamageEffectSpecHandle.Data->SetSetByCallerMagnitude(FName("StaggerCoefficient"), StaggerCoefficient);
+		URsBattleLibrary::ApplyDamageEffectSpec(GetAvatarActorFromActorInfo(), Victim, DamageEffectSpecHandle);
+	}
+}
+
+void URsGameplayAbility_Melee::ApplyDamageToCrowd()
+{
+	URsCrowdSubsystem* CrowdSubsystem = URsCrowdSubsystem::Get(GetAvatarActorFromActorInfo());
+	const UAbilitySystemComponent* AbilitySystemComponent = GetAbilitySystemComponentFromActorInfo();
+	if (CrowdSubsystem == nullptr || AbilitySystemComponent == nullptr || CrowdSubsystem->GetNumCrowdEntities() == 0)
+	{
+		return;
+	}
+
+	const float Damage = FMath::Max(AbilitySystemComponent->GetNumericAttribute(URsAttackSet::GetAttackAttribute()), 0.f) * DamageCoefficient;
+	const float StaggerDamage = FMath::Max(AbilitySystemComponent->GetNumericAttribute(URsAttackSet::GetImpactAttribute()), 0.f) * StaggerCoefficient;
+	AActor* AvatarActor = GetAvatarActorFromActorInfo();
+	CrowdSubsystem->ApplyRadialDamage(AvatarActor->GetActorLocation(), CrowdDamageRadius, Damage, StaggerDamage, URsAILibrary::GetTeamID(AvatarActor));
 }
@@ -17,15 +17,25 @@ class RS_API URsGameplayAbility_Melee : public URsGameplayAbility_Attack
 	GENERATED_BODY()
 
 protected:
-	// Tag that define hit detect event
+	// Tag that define hit detect event.
+	// Events without a target run "Damage Targeting Preset", events with a target (e.g. from weapon trace) damage that target only.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RS|Montage", meta = (Categories = "Event"))
 	FGameplayTag HitDetectEventTag;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RS|Damage")
 	UTargetingPreset* DamageTargetingPreset;
 
+	// Crowd entities within this distance from the avatar take the hit in the batched crowd damage pass, as they are not actors the targeting preset can find. 0 means none.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RS|Damage")
+	float CrowdDamageRadius = 0.f;
+
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
 	
 	UFUNCTION()
 	void HandleHitDetect(FGameplayEventData EventData);
+
+	void ApplyDamageToVictim(AActor* Victim);
+
+	// Same damage and stagger formula as the exec calculations, without the target's defense.
+	void ApplyDamageToCrowd();
 };
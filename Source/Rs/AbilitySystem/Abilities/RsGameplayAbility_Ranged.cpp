@@ -9,12 +9,15 @@
 #include "Rs/AbilitySystem/AbilityTask/RsAbilityTask_TurnToLocation.h"
 #include "Rs/Battle/RsBattleLibrary.h"
 #include "Rs/Battle/Actor/RsProjectile.h"
+#include "Rs/Battle/Subsystem/RsProjectilePredictionSubsystem.h"
 #include "Rs/Character/RsCharacterBase.h"
 
 void URsGameplayAbility_Ranged::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
+	FireCount = 0;
+	
 	if (FocusTargetingPreset)
 	{
 		TArray<AActor*> Victims;
@@ -55,6 +58,32 @@ void URsGameplayAbility_Ranged::EndAbility(const FGameplayAbilitySpecHandle Hand
 }
 
 void URsGameplayAbility_Ranged::HandleFireProjectile(FGameplayEventData EventData)
+{
+	// Kept in server builds, the owning client matches its cosmetic projectile to the replicated ID of the server projectile.
+	const int32 PredictionId = URsProjectilePredictionSubsystem::MakePredictionId(GetCurrentActivationInfo().GetActivationPredictionKey().Current, FireCount++);
+	
+	if (HasAuthority(&CurrentActivationInfo))
+	{
+		SpawnProjectile(false, PredictionId);
+	}
+#if !UE_SERVER
+	else if (IsLocallyControlled())
+	{
+		// Owning client shows its shot immediately instead of waiting a round trip for the server projectile.
+		ARsProjectile* CosmeticProjectile = nullptr;
+		if (PredictionId != INDEX_NONE && URsProjectilePredictionSubsystem::IsPredictionEnabled())
+		{
+			CosmeticProjectile = SpawnProjectile(true, PredictionId);
+		}
+		if (URsProjectilePredictionSubsystem* PredictionSubsystem = URsProjectilePredictionSubsystem::Get(GetAvatarActorFromActorInfo()))
+		{
+			PredictionSubsystem->RegisterPredictedFire(GetAvatarActorFromActorInfo(), PredictionId, CosmeticProjectile);
+		}
+	}
+#endif
+}
+
+ARsProjectile* URsGameplayAbility_Ranged::SpawnProjectile(bool bCosmeticOnly, int32 PredictionId)
 {
 	ARsCharacterBase* Source = GetAvatarCharacter();
 
@@ -67,12 +96,22 @@ void URsGameplayAbility_Ranged::HandleFireProjectile(FGameplayEventData EventDat
 	}
 
 	ARsProjectile* Projectile = GetWorld()->SpawnActorDeferred<ARsProjectile>(ProjectileClass, ProjectileTransform, Source, Source, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
-	FGameplayEffectSpecHandle DamageEffectSpecHandle = MakeOutgoingGameplayEffectSpec(DamageEffectClass, GetAbilityLevel());
-	if (DamageEffectSpecHandle.IsValid())
+	Projectile->PredictionId = PredictionId;
+	Projectile->bCosmeticOnly = bCosmeticOnly;
+	if (bCosmeticOnly)
+	{
+		// Cosmetic projectile has no damage spec, so it never deals damage.
+		Projectile->SetReplicates(false);
+	}
+	else
 	{
-		DamageEffectSpecHandle.Data->SetSetByCallerMagnitude(FName("DamageCoefficient"), DamageCoefficient);
-		DamageEffectSpecHandle.Data->SetSetByCallerMagnitude(FName("StaggerCoefficient"), StaggerCoefficient);
-		Projectile->DamageSpecHandle = DamageEffectSpecHandle;
+		FGameplayEffectSpecHandle DamageEffectSpecHandle = MakeOutgoingGameplayEffectSpec(DamageEffectClass, GetAbilityLevel());
+		if (DamageEffectSpecHandle.IsValid())
+		{
+			DamageEffectSpecHandle.Data->SetSetByCallerMagnitude(FName("DamageCoefficient"), DamageCoefficient);
+			DamageEffectSpecHandle.Data->SetSetByCallerMagnitude(FName("StaggerCoefficient"), StaggerCoefficient);
+			Projectile->DamageSpecHandle = DamageEffectSpecHandle;
+		}
 	}
 	if (CachedVictim.IsValid())
 	{
@@ -80,6 +119,7 @@ void URsGameplayAbility_Ranged::HandleFireProjectile(FGameplayEventData EventDat
 	}
 	
 	Projectile->FinishSpawning(AvatarCharacter->GetActorTransform());
+	return Projectile;
 }
 
 void URsGameplayAbility_Ranged::HandleInstantDamage()
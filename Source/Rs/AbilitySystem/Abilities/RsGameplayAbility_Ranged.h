@@ -35,6 +35,13 @@ protected:
 	UFUNCTION()
 	void HandleInstantDamage();
 
+	// Spawns the projectile. Cosmetic projectiles are spawned by the owning client ahead of the server projectile.
+	ARsProjectile* SpawnProjectile(bool bCosmeticOnly, int32 PredictionId);
+
 	UPROPERTY(Transient)
 	TWeakObjectPtr<AActor> CachedVictim = nullptr;
+
+private:
+	// Number of projectiles fired in the current activation. Used to make prediction IDs.
+	int32 FireCount = 0;
 };
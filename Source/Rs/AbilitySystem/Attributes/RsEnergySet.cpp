@@ -6,6 +6,7 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GameplayEffectExtension.h"
 #include "Net/UnrealNetwork.h"
+#include "Rs/Battle/RsCombatStats.h"
 
 URsEnergySet::URsEnergySet()
 {
@@ -48,6 +49,8 @@ void URsEnergySet::PreAttributeChange(const FGameplayAttribute& Attribute, float
 
 void URsEnergySet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
+	RS_COMBAT_SCOPE(RsEnergySet_PostGameplayEffectExecute);
+
 	Super::PostGameplayEffectExecute(Data);
 	
 	if (Data.EvaluatedData.Attribute == GetCurrentEnergyAttribute())
@@ -6,6 +6,9 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GameplayEffectExtension.h"
 #include "Net/UnrealNetwork.h"
+#include "Rs/Battle/RsCombatStats.h"
+
+DEFINE_STAT(STAT_RsCombatDeaths);
 
 URsHealthSet::URsHealthSet()
 {
@@ -48,6 +51,8 @@ void URsHealthSet::PreAttributeChange(const FGameplayAttribute& Attribute, float
 
 void URsHealthSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
+	RS_COMBAT_SCOPE(RsHealthSet_PostGameplayEffectExecute);
+
 	Super::PostGameplayEffectExecute(Data);
 
 	if (Data.EvaluatedData.Attribute == GetDamageAttribute())
@@ -93,12 +98,15 @@ void URsHealthSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackDat
 
 void URsHealthSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
 {
+	RS_COMBAT_SCOPE(RsHealthSet_PostAttributeChange);
+
 	Super::PostAttributeChange(Attribute, OldValue, NewValue);
 	
 	if (Attribute == GetCurrentHealthAttribute())
 	{
 		if (NewValue <= 0.f && OldValue > 0.f)
 		{
+			INC_DWORD_STAT(STAT_RsCombatDeaths);
 			FGameplayTag DeathTag = FGameplayTag::RequestGameplayTag(TEXT("Ability.Death"));
 			UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetOwningActor(), DeathTag, FGameplayEventData());
 		}
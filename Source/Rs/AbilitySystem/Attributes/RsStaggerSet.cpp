@@ -6,6 +6,9 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GameplayEffectExtension.h"
 #include "Net/UnrealNetwork.h"
+#include "Rs/Battle/RsCombatStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stuns"), STAT_RsCombatStuns, STATGROUP_RsCombat);
 
 URsStaggerSet::URsStaggerSet()
 {
@@ -31,6 +34,8 @@ void URsStaggerSet::PreAttributeChange(const FGameplayAttribute& Attribute, floa
 
 void URsStaggerSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
+	RS_COMBAT_SCOPE(RsStaggerSet_PostGameplayEffectExecute);
+
 	Super::PostGameplayEffectExecute(Data);
 
 	if (Data.EvaluatedData.Attribute == GetStaggerGainAttribute())
@@ -61,10 +66,17 @@ void URsStaggerSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackDa
 
 void URsStaggerSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
 {
+	RS_COMBAT_SCOPE(RsStaggerSet_PostAttributeChange);
+
 	Super::PostAttributeChange(Attribute, OldValue, NewValue);
 
 	if (CurrentStagger.GetCurrentValue() >= MaxStagger.GetCurrentValue())
 	{
+		// Count only the change that reaches max stagger, not every later attribute change while it stays there.
+		if (Attribute == GetCurrentStaggerAttribute() && OldValue < MaxStagger.GetCurrentValue() && NewValue >= MaxStagger.GetCurrentValue())
+		{
+			INC_DWORD_STAT(STAT_RsCombatStuns);
+		}
 		FGameplayTag StunTag = FGameplayTag::RequestGameplayTag(TEXT("Ability.Stun"));
 		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetOwningActor(), StunTag, FGameplayEventData());
 	}
@@ -7,6 +7,10 @@
 #include "Rs/AbilitySystem/Attributes/RsDefenseSet.h"
 #include "Rs/AbilitySystem/Attributes/RsHealthSet.h"
 #include "Rs/AbilitySystem/Effect/RsGameplayEffectContext.h"
+#include "Rs/Battle/RsCombatStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hits"), STAT_RsCombatHits, STATGROUP_RsCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Critical Hits"), STAT_RsCombatCriticalHits, STATGROUP_RsCombat);
 
 // Declare the attributes to capture and define how we want to capture them from the Source and Target.
 struct RsDamageStatics
@@ -49,6 +53,8 @@ URsDamageExecCalculation::URsDamageExecCalculation()
 
 void URsDamageExecCalculation::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
 {
+	RS_COMBAT_SCOPE(RsDamageExecCalculation);
+
 	UAbilitySystemComponent* TargetASC = ExecutionParams.GetTargetAbilitySystemComponent();
 	if (TargetASC == nullptr)
 	{
@@ -109,4 +115,10 @@ void URsDamageExecCalculation::Execute_Implementation(const FGameplayEffectCusto
 	}
 
 	OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(DamageStatics->DamageProperty, EGameplayModOp::Additive, FinalDamage));
+
+	INC_DWORD_STAT(STAT_RsCombatHits);
+	if (bCriticalHit)
+	{
+		INC_DWORD_STAT(STAT_RsCombatCriticalHits);
+	}
 }
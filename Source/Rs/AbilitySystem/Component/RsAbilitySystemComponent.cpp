@@ -86,6 +86,15 @@ void URsAbilitySystemComponent::InitializeAbilitySystem(URsAbilitySet* AbilitySe
 
 void URsAbilitySystemComponent::UninitializeAbilitySystem()
 {
+	// Nothing to catch up on. The effects are removed and the base values set again on the next initialization.
+	if (bPeriodicEffectsSuspended)
+	{
+		OnAnyGameplayEffectRemovedDelegate().Remove(SuspendedEffectRemovedHandle);
+		SuspendedEffectRemovedHandle.Reset();
+		SuspendedPeriodicEffects.Reset();
+		bPeriodicEffectsSuspended = false;
+	}
+
 	ClearAllAbilities();
 	GrantedAbilityHandles.Reset();
 	
@@ -98,6 +107,105 @@ void URsAbilitySystemComponent::UninitializeAbilitySystem()
 	GrantedAttributeSets.Reset();
 }
 
+void URsAbilitySystemComponent::SuspendPeriodicEffects()
+{
+	if (bPeriodicEffectsSuspended || !IsOwnerActorAuthoritative())
+	{
+		return;
+	}
+	bPeriodicEffectsSuspended = true;
+	PeriodicEffectsSuspendTime = GetWorld()->GetTimeSeconds();
+
+	for (const FActiveGameplayEffect& ActiveEffect : &ActiveGameplayEffects)
+	{
+		if (ActiveEffect.GetPeriod() > 0.f && !ActiveEffect.bIsInhibited)
+		{
+			SuspendedPeriodicEffects.Add(ActiveEffect.Handle);
+		}
+	}
+	for (FActiveGameplayEffectHandle Handle : SuspendedPeriodicEffects)
+	{
+		SetActiveGameplayEffectInhibit(MoveTemp(Handle), true, false);
+	}
+
+	SuspendedEffectRemovedHandle = OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &ThisClass::HandleSuspendedEffectRemoved);
+}
+
+void URsAbilitySystemComponent::ResumePeriodicEffects()
+{
+	if (!bPeriodicEffectsSuspended)
+	{
+		return;
+	}
+	bPeriodicEffectsSuspended = false;
+	OnAnyGameplayEffectRemovedDelegate().Remove(SuspendedEffectRemovedHandle);
+	SuspendedEffectRemovedHandle.Reset();
+
+	// Additive modifiers of every missed execution are summed, so regeneration catches up in one step.
+	const double Now = GetWorld()->GetTimeSeconds();
+	TMap<FGameplayAttribute, float> CatchUp;
+	for (FActiveGameplayEffectHandle Handle : SuspendedPeriodicEffects)
+	{
+		if (const FActiveGameplayEffect* ActiveEffect = GetActiveGameplayEffect(Handle))
+		{
+			AccrueMissedExecutions(*ActiveEffect, Now, CatchUp);
+			SetActiveGameplayEffectInhibit(MoveTemp(Handle), false, false);
+		}
+	}
+	SuspendedPeriodicEffects.Reset();
+
+	ApplyCatchUp(CatchUp);
+}
+
+void URsAbilitySystemComponent::AccrueMissedExecutions(const FActiveGameplayEffect& ActiveEffect, double EndTime, TMap<FGameplayAttribute, float>& OutCatchUp) const
+{
+	const int32 MissedExecutions = FMath::FloorToInt32((EndTime - PeriodicEffectsSuspendTime) / ActiveEffect.GetPeriod());
+	const FGameplayEffectSpec& Spec = ActiveEffect.Spec;
+	for (int32 ModifierIndex = 0; MissedExecutions > 0 && ModifierIndex < Spec.Modifiers.Num(); ++ModifierIndex)
+	{
+		const FGameplayModifierInfo& ModifierInfo = Spec.Def->Modifiers[ModifierIndex];
+		if (ModifierInfo.ModifierOp == EGameplayModOp::Additive)
+		{
+			OutCatchUp.FindOrAdd(ModifierInfo.Attribute) += Spec.GetModifierMagnitude(ModifierIndex, true) * MissedExecutions;
+		}
+	}
+}
+
+void URsAbilitySystemComponent::ApplyCatchUp(const TMap<FGameplayAttribute, float>& CatchUp)
+{
+	if (CatchUp.IsEmpty())
+	{
+		return;
+	}
+
+	// Goes through the attribute sets' clamping like any other instant effect.
+	UGameplayEffect* CatchUpEffect = NewObject<UGameplayEffect>(GetTransientPackage());
+	CatchUpEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+	for (const TTuple<FGameplayAttribute, float>& AttributeCatchUp : CatchUp)
+	{
+		FGameplayModifierInfo& CatchUpModifier = CatchUpEffect->Modifiers.AddDefaulted_GetRef();
+		CatchUpModifier.Attribute = AttributeCatchUp.Key;
+		CatchUpModifier.ModifierOp = EGameplayModOp::Additive;
+		CatchUpModifier.ModifierMagnitude = FScalableFloat(AttributeCatchUp.Value);
+	}
+	ApplyGameplayEffectToSelf(CatchUpEffect, 1.f, MakeEffectContext());
+}
+
+void URsAbilitySystemComponent::HandleSuspendedEffectRemoved(const FActiveGameplayEffect& ActiveEffect)
+{
+	if (SuspendedPeriodicEffects.RemoveSingleSwap(ActiveEffect.Handle) == 0)
+	{
+		return;
+	}
+
+	// An expired effect only ran until its end time.
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float EndTime = ActiveEffect.GetEndTime();
+	TMap<FGameplayAttribute, float> CatchUp;
+	AccrueMissedExecutions(ActiveEffect, EndTime > 0.f ? FMath::Min<double>(Now, EndTime) : Now, CatchUp);
+	ApplyCatchUp(CatchUp);
+}
+
 int32 URsAbilitySystemComponent::HandleGameplayEvent(FGameplayTag EventTag, const FGameplayEventData* Payload)
 {
 	FGameplayEventData OutPayload;
@@ -107,3 +215,57 @@ int32 URsAbilitySystemComponent::HandleGameplayEvent(FGameplayTag EventTag, cons
 	return Super::HandleGameplayEvent(EventTag, Payload);
 }
 
+FGameplayAbilitySpecHandle URsAbilitySystemComponent::FindAbilitySpecHandleWithTag(const FGameplayTag& AbilityTag, bool bExactMatch) const
+{
+	if (bAbilityTagIndexDirty)
+	{
+		RebuildAbilityTagIndex();
+	}
+
+	const TMap<FGameplayTag, FGameplayAbilitySpecHandle>& TagIndex = bExactMatch ? ExactAbilityTagIndex : AbilityTagIndex;
+	if (const FGameplayAbilitySpecHandle* FoundHandle = TagIndex.Find(AbilityTag))
+	{
+		return *FoundHandle;
+	}
+	return FGameplayAbilitySpecHandle();
+}
+
+void URsAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	bAbilityTagIndexDirty = true;
+}
+
+void URsAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnRemoveAbility(AbilitySpec);
+
+	bAbilityTagIndexDirty = true;
+}
+
+void URsAbilitySystemComponent::RebuildAbilityTagIndex() const
+{
+	ExactAbilityTagIndex.Reset();
+	AbilityTagIndex.Reset();
+
+	// Keep the first spec for each tag, same as FindAllAbilitiesWithTags()[0].
+	for (const FGameplayAbilitySpec& Spec : GetActivatableAbilities())
+	{
+		if (Spec.Ability == nullptr || Spec.PendingRemove)
+		{
+			continue;
+		}
+		
+		for (const FGameplayTag& AbilityTag : Spec.Ability->GetAssetTags())
+		{
+			ExactAbilityTagIndex.FindOrAdd(AbilityTag, Spec.Handle);
+			for (const FGameplayTag& ParentTag : AbilityTag.GetGameplayTagParents())
+			{
+				AbilityTagIndex.FindOrAdd(ParentTag, Spec.Handle);
+			}
+		}
+	}
+	
+	bAbilityTagIndexDirty = false;
+}
@@ -26,12 +26,49 @@ public:
 	void UninitializeAbilitySystem();
 
 	FGameplayEventMulticastDelegate OnAnyGameplayEvent;
+
+	// Stops executing periodic effects. (e.g. regeneration of a dormant party member) Durations and cooldowns keep running.
+	void SuspendPeriodicEffects();
+
+	// Applies the executions missed while suspended as a single instant effect, then resumes periodic execution.
+	// Effects removed or expired while suspended are caught up at that moment, up to their end time.
+	void ResumePeriodicEffects();
+
+	// Returns the first granted ability that has the tag. Uses a tag index that is rebuilt only when abilities are given or removed.
+	FGameplayAbilitySpecHandle FindAbilitySpecHandleWithTag(const FGameplayTag& AbilityTag, bool bExactMatch = true) const;
+
+protected:
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
 	
 private:
 	bool AbilitySystemDataInitialized = false;
 
 	virtual int32 HandleGameplayEvent(FGameplayTag EventTag, const FGameplayEventData* Payload) override;
 
+	void RebuildAbilityTagIndex() const;
+
+	// Ability asset tag -> first ability spec handle with that tag.
+	mutable TMap<FGameplayTag, FGameplayAbilitySpecHandle> ExactAbilityTagIndex;
+
+	// Same as above, but also indexed by the parent tags of each ability tag.
+	mutable TMap<FGameplayTag, FGameplayAbilitySpecHandle> AbilityTagIndex;
+
+	mutable bool bAbilityTagIndexDirty = true;
+
+	// Sums the additive modifiers of the executions the effect missed between the suspend time and EndTime.
+	void AccrueMissedExecutions(const FActiveGameplayEffect& ActiveEffect, double EndTime, TMap<FGameplayAttribute, float>& OutCatchUp) const;
+	void ApplyCatchUp(const TMap<FGameplayAttribute, float>& CatchUp);
+
+	// Catches up a suspended effect that is removed or expires before ResumePeriodicEffects.
+	void HandleSuspendedEffectRemoved(const FActiveGameplayEffect& ActiveEffect);
+
+	// Periodic effects inhibited by SuspendPeriodicEffects.
+	TArray<FActiveGameplayEffectHandle> SuspendedPeriodicEffects;
+	FDelegateHandle SuspendedEffectRemovedHandle;
+	double PeriodicEffectsSuspendTime = 0.0;
+	bool bPeriodicEffectsSuspended = false;
+
 	// Handles to the granted abilities.
 	UPROPERTY()
 	TArray<FGameplayAbilitySpecHandle> GrantedAbilityHandles;
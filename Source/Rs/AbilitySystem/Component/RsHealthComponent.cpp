@@ -3,6 +3,7 @@
 
 #include "RsHealthComponent.h"
 
+#include "AbilitySystemComponent.h"
 #include "GameplayEffectExtension.h"
 #include "Rs/AbilitySystem/Attributes/RsHealthSet.h"
 
@@ -16,10 +17,17 @@ URsHealthComponent::URsHealthComponent()
 
 void URsHealthComponent::Initialize(UAbilitySystemComponent* AbilitySystemComponent)
 {
-	if (AbilitySystemComponent == nullptr)
+	if (AbilitySystemComponent == nullptr || AbilitySystemComponent == BoundAbilitySystem)
 	{
 		return;
 	}
+
+	// Party members are handed between ability systems on possession. Drop the binding to the previous one.
+	if (UAbilitySystemComponent* OldAbilitySystem = BoundAbilitySystem.Get())
+	{
+		OldAbilitySystem->GetGameplayAttributeValueChangeDelegate(URsHealthSet::GetCurrentHealthAttribute()).RemoveAll(this);
+	}
+	BoundAbilitySystem = AbilitySystemComponent;
 	
 	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(URsHealthSet::GetCurrentHealthAttribute()).AddUObject(this, &ThisClass::HandleHealthChanged);
 	HealthSet = AbilitySystemComponent->GetSet<URsHealthSet>();
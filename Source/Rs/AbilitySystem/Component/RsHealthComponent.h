@@ -36,4 +36,6 @@ protected:
 
 	UPROPERTY()
 	TObjectPtr<const URsHealthSet> HealthSet;
+
+	TWeakObjectPtr<UAbilitySystemComponent> BoundAbilitySystem;
 };
@@ -5,6 +5,7 @@
 
 #include "AbilitySystemComponent.h"
 #include "Abilities/RsGameplayAbility.h"
+#include "Component/RsAbilitySystemComponent.h"
 
 UGameplayAbility* URsAbilitySystemLibrary::FindAbilityWithTag(const UAbilitySystemComponent* AbilitySystemComponent, FGameplayTagContainer AbilityTags, bool bExactMatch)
 {
@@ -13,14 +14,29 @@ UGameplayAbility* URsAbilitySystemLibrary::FindAbilityWithTag(const UAbilitySyst
 		return nullptr;
 	}
 
-	TArray<FGameplayAbilitySpecHandle> OutHandles;
-	AbilitySystemComponent->FindAllAbilitiesWithTags(OutHandles, AbilityTags, bExactMatch);
-	if (OutHandles.IsEmpty())
+	FGameplayAbilitySpecHandle FoundHandle;
+	const URsAbilitySystemComponent* RsASC = Cast<URsAbilitySystemComponent>(AbilitySystemComponent);
+	if (RsASC && AbilityTags.Num() == 1)
 	{
-		return nullptr;
+		// Single tag lookups are served by the tag index instead of scanning every spec.
+		FoundHandle = RsASC->FindAbilitySpecHandleWithTag(AbilityTags.First(), bExactMatch);
+	}
+	else
+	{
+		TArray<FGameplayAbilitySpecHandle> OutHandles;
+		AbilitySystemComponent->FindAllAbilitiesWithTags(OutHandles, AbilityTags, bExactMatch);
+		if (!OutHandles.IsEmpty())
+		{
+			FoundHandle = OutHandles[0];
+		}
 	}
 
-	FGameplayAbilitySpec* FoundSpec = AbilitySystemComponent->FindAbilitySpecFromHandle(OutHandles[0]);
+	FGameplayAbilitySpec* FoundSpec = AbilitySystemComponent->FindAbilitySpecFromHandle(FoundHandle);
+	if (FoundSpec == nullptr)
+	{
+		return nullptr;
+	}
+	
 	UGameplayAbility* AbilityInstance = FoundSpec->GetPrimaryInstance();
 	if (AbilityInstance == nullptr)
 	{
@@ -6,8 +6,11 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "AbilitySystemGlobals.h"
+#include "Net/UnrealNetwork.h"
 #include "Rs/AI/RsAILibrary.h"
 #include "Rs/Battle/RsBattleLibrary.h"
+#include "Rs/Battle/RsCombatStats.h"
+#include "Rs/Battle/Subsystem/RsProjectilePredictionSubsystem.h"
 
 
 ARsProjectile::ARsProjectile()
@@ -23,6 +26,13 @@ ARsProjectile::ARsProjectile()
 	ProjectileMovement = CreateDefaultSubobject<UProjectileMovementComponent>(FName("ProjectileMovement"));
 }
 
+void ARsProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(ThisClass, PredictionId, COND_InitialOnly);
+}
+
 void ARsProjectile::BeginPlay()
 {
 	Super::BeginPlay();
@@ -31,10 +41,45 @@ void ARsProjectile::BeginPlay()
 	{
 		SetLifeSpan(MaxRange / ProjectileMovement->MaxSpeed);
 	}
+
+#if !UE_SERVER
+	// Server projectile arrived on a client, find the cosmetic projectile that was predicted for it.
+	if (GetLocalRole() != ROLE_Authority && PredictionId != INDEX_NONE)
+	{
+		if (URsProjectilePredictionSubsystem* PredictionSubsystem = URsProjectilePredictionSubsystem::Get(this))
+		{
+			PredictionSubsystem->ReconcileProjectile(this);
+		}
+	}
+#endif
+}
+
+void ARsProjectile::Destroyed()
+{
+	if (ARsProjectile* CosmeticProjectile = LinkedCosmeticProjectile.Get())
+	{
+		CosmeticProjectile->Destroy();
+	}
+	
+	Super::Destroyed();
+}
+
+void ARsProjectile::LinkCosmeticProjectile(ARsProjectile* CosmeticProjectile)
+{
+	LinkedCosmeticProjectile = CosmeticProjectile;
+	SetActorHiddenInGame(true);
+	
+	// The server projectile decides lifetime, so the cosmetic one shouldn't expire on its own.
+	if (CosmeticProjectile)
+	{
+		CosmeticProjectile->SetLifeSpan(0.f);
+	}
 }
 
 void ARsProjectile::HandleBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	RS_COMBAT_SCOPE(RsProjectile_HandleBeginOverlap);
+
 	if (!DamageSpecHandle.IsValid())
 	{
 		return;
@@ -62,5 +107,7 @@ void ARsProjectile::HandleBeginOverlap(UPrimitiveComponent* OverlappedComponent,
 
 void ARsProjectile::HandleBlock(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
+	RS_COMBAT_SCOPE(RsProjectile_HandleBlock);
+
 	Destroy();
 }
\ No newline at end of file
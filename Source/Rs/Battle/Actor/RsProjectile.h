@@ -38,12 +38,29 @@ public:
 	UPROPERTY(BlueprintReadWrite, Meta = (ExposeOnSpawn = true))
 	bool bCannotHitFriend = true;
 
+	// Shared by the server projectile and the cosmetic projectile predicted by the owning client. INDEX_NONE if not predicted.
+	UPROPERTY(Replicated)
+	int32 PredictionId = INDEX_NONE;
+
+	// Cosmetic projectiles are spawned locally by the owning client. They never deal damage.
+	UPROPERTY(BlueprintReadOnly)
+	bool bCosmeticOnly = false;
+
+	// Hides this server projectile on the owning client and destroys the cosmetic projectile together with it.
+	void LinkCosmeticProjectile(ARsProjectile* CosmeticProjectile);
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void Destroyed() override;
 	
 	UFUNCTION()
 	void HandleBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
 	UFUNCTION()
 	void HandleBlock(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+private:
+	TWeakObjectPtr<ARsProjectile> LinkedCosmeticProjectile;
 };
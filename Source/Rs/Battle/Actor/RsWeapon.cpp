@@ -3,6 +3,8 @@
 
 #include "RsWeapon.h"
 
+#include "Components/MeshComponent.h"
+
 ARsWeapon::ARsWeapon()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -14,5 +16,40 @@ ARsWeapon::ARsWeapon()
 void ARsWeapon::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	// Cache the first mesh that has the trace sockets, so weapon traces don't have to search components every frame.
+	TInlineComponentArray<UMeshComponent*> MeshComponents(this);
+	for (UMeshComponent* MeshComponent : MeshComponents)
+	{
+		if (TraceSocketNames.IsEmpty() || MeshComponent->DoesSocketExist(TraceSocketNames[0]))
+		{
+			TraceMeshComponent = MeshComponent;
+			break;
+		}
+	}
+}
+
+UMeshComponent* ARsWeapon::GetTraceMeshComponent() const
+{
+	return TraceMeshComponent;
+}
+
+void ARsWeapon::GetTraceSocketLocalLocations(TArray<FVector>& OutLocations) const
+{
+	if (TraceMeshComponent == nullptr)
+	{
+		return;
+	}
+
+	for (const FName& SocketName : TraceSocketNames)
+	{
+		if (TraceMeshComponent->DoesSocketExist(SocketName))
+		{
+			OutLocations.Add(TraceMeshComponent->GetSocketTransform(SocketName, RTS_Component).GetLocation());
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RsWeapon::GetTraceSocketLocalLocations: Socket %s Not Found"), *SocketName.ToString());
+		}
+	}
 }
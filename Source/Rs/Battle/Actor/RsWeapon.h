@@ -6,6 +6,8 @@
 #include "GameFramework/Actor.h"
 #include "RsWeapon.generated.h"
 
+class UMeshComponent;
+
 UCLASS()
 class RS_API ARsWeapon : public AActor
 {
@@ -14,6 +16,24 @@ class RS_API ARsWeapon : public AActor
 public:	
 	ARsWeapon();
 
+	// Sockets on the weapon mesh that are swept during a weapon trace. (e.g. blade base, middle and tip)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "RS|Trace")
+	TArray<FName> TraceSocketNames;
+
+	// Radius of the sphere swept from each trace socket.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "RS|Trace")
+	float TraceRadius = 10.f;
+
+	// Returns the mesh component that owns the trace sockets.
+	UMeshComponent* GetTraceMeshComponent() const;
+
+	// Returns trace socket locations in the space of the trace mesh component.
+	void GetTraceSocketLocalLocations(TArray<FVector>& OutLocations) const;
+
 protected:
 	virtual void BeginPlay() override;
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<UMeshComponent> TraceMeshComponent;
 };
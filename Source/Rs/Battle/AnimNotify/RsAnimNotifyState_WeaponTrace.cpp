@@ -0,0 +1,72 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsAnimNotifyState_WeaponTrace.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Rs/Battle/Actor/RsWeapon.h"
+
+void URsAnimNotifyState_WeaponTrace::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
+
+	AActor* Owner = MeshComp ? MeshComp->GetOwner() : nullptr;
+	if (Owner == nullptr)
+	{
+		return;
+	}
+
+	// Hits are only meaningful where the ability can run. (Server or owning client)
+	const APawn* OwnerPawn = Cast<APawn>(Owner);
+	if (!Owner->HasAuthority() && !(OwnerPawn && OwnerPawn->IsLocallyControlled()))
+	{
+		return;
+	}
+	
+	if (ARsWeapon* Weapon = FindWeapon(MeshComp))
+	{
+		if (URsWeaponTraceSubsystem* WeaponTraceSubsystem = URsWeaponTraceSubsystem::Get(MeshComp))
+		{
+			WeaponTraceSubsystem->BeginSwing(MeshComp, Weapon, Owner, TraceParams);
+		}
+	}
+}
+
+void URsAnimNotifyState_WeaponTrace::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	if (ARsWeapon* Weapon = FindWeapon(MeshComp))
+	{
+		if (URsWeaponTraceSubsystem* WeaponTraceSubsystem = URsWeaponTraceSubsystem::Get(MeshComp))
+		{
+			WeaponTraceSubsystem->EndSwing(MeshComp, Weapon);
+		}
+	}
+	
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+}
+
+FString URsAnimNotifyState_WeaponTrace::GetNotifyName_Implementation() const
+{
+	return TEXT("Weapon Trace");
+}
+
+ARsWeapon* URsAnimNotifyState_WeaponTrace::FindWeapon(const USkeletalMeshComponent* MeshComp)
+{
+	const AActor* Owner = MeshComp ? MeshComp->GetOwner() : nullptr;
+	if (Owner == nullptr)
+	{
+		return nullptr;
+	}
+	
+	TArray<AActor*> AttachedActors;
+	Owner->GetAttachedActors(AttachedActors);
+	for (AActor* AttachedActor : AttachedActors)
+	{
+		if (ARsWeapon* Weapon = Cast<ARsWeapon>(AttachedActor))
+		{
+			return Weapon;
+		}
+	}
+	return nullptr;
+}
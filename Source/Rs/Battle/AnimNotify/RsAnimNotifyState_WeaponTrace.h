@@ -0,0 +1,32 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "Rs/Battle/Subsystem/RsWeaponTraceSubsystem.h"
+#include "RsAnimNotifyState_WeaponTrace.generated.h"
+
+class ARsWeapon;
+
+/**
+ * Sweeps the trace sockets of the owner's ARsWeapon while the notify state is active.
+ * Each hit actor is sent to the owner once as a gameplay event with "Hit Event Tag".
+ */
+UCLASS(meta = (DisplayName = "RS Weapon Trace"))
+class RS_API URsAnimNotifyState_WeaponTrace : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+	virtual FString GetNotifyName_Implementation() const override;
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RS", meta = (ShowOnlyInnerProperties))
+	FRsWeaponTraceParams TraceParams;
+
+private:
+	static ARsWeapon* FindWeapon(const USkeletalMeshComponent* MeshComp);
+};
@@ -5,11 +5,16 @@
 
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
+#include "GameFramework/PlayerState.h"
 #include "Rs/AbilitySystem/Effect/RsGameplayEffectContext.h"
+#include "Rs/Battle/RsCombatStats.h"
+#include "Rs/Battle/Subsystem/RsActorHistorySubsystem.h"
 #include "TargetingSystem/TargetingSubsystem.h"
 
 bool URsBattleLibrary::ExecuteTargeting(AActor* SourceActor, const UTargetingPreset* TargetingPreset, TArray<AActor*>& ResultActors)
 {
+	RS_COMBAT_SCOPE(RsBattleLibrary_ExecuteTargeting);
+
 	if (SourceActor == nullptr || TargetingPreset == nullptr)
 	{
 		return false;
@@ -43,8 +48,59 @@ bool URsBattleLibrary::ExecuteTargeting(AActor* SourceActor, const UTargetingPre
 	return !ResultActors.IsEmpty();
 }
 
+bool URsBattleLibrary::ExecuteLagCompensatedTargeting(AActor* SourceActor, const UTargetingPreset* TargetingPreset, TArray<AActor*>& ResultActors)
+{
+	RS_COMBAT_SCOPE(RsBattleLibrary_ExecuteLagCompensatedTargeting);
+
+	if (SourceActor == nullptr || TargetingPreset == nullptr)
+	{
+		return false;
+	}
+
+	const double ClientViewTime = GetClientViewTime(SourceActor);
+	if (ClientViewTime >= SourceActor->GetWorld()->GetTimeSeconds())
+	{
+		return ExecuteTargeting(SourceActor, TargetingPreset, ResultActors);
+	}
+
+	FRsScopedActorRewind ScopedRewind(SourceActor, ClientViewTime);
+	return ExecuteTargeting(SourceActor, TargetingPreset, ResultActors);
+}
+
+double URsBattleLibrary::GetClientViewTime(const AActor* SourceActor)
+{
+	const UWorld* World = SourceActor ? SourceActor->GetWorld() : nullptr;
+	if (World == nullptr)
+	{
+		return 0.0;
+	}
+	
+	const double Now = World->GetTimeSeconds();
+	const APawn* SourcePawn = Cast<APawn>(SourceActor);
+	if (!SourceActor->HasAuthority() || SourcePawn == nullptr || SourcePawn->IsLocallyControlled())
+	{
+		return Now;
+	}
+
+	const APlayerState* PlayerState = SourcePawn->GetPlayerState();
+	if (PlayerState == nullptr)
+	{
+		return Now;
+	}
+	
+	// Remote client sees other characters one trip late, and its hit request arrives one trip later.
+	const double RoundTripTime = PlayerState->GetPingInMilliseconds() * 0.001;
+	if (const URsActorHistorySubsystem* HistorySubsystem = URsActorHistorySubsystem::Get(SourceActor))
+	{
+		return FMath::Max(Now - RoundTripTime, HistorySubsystem->GetOldestRewindTime());
+	}
+	return Now;
+}
+
 void URsBattleLibrary::ApplyDamageEffect(AActor* SourceActor, AActor* TargetActor, TSubclassOf<UGameplayEffect> GameplayEffectClass)
 {
+	RS_COMBAT_SCOPE(RsBattleLibrary_ApplyDamageEffect);
+
 	UAbilitySystemComponent* SourceASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(SourceActor);
 	UAbilitySystemComponent* TargetASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(TargetActor);
 	
@@ -57,6 +113,8 @@ void URsBattleLibrary::ApplyDamageEffect(AActor* SourceActor, AActor* TargetActo
 
 void URsBattleLibrary::ApplyDamageEffectSpec(AActor* SourceActor, AActor* TargetActor, const FGameplayEffectSpecHandle& EffectHandle)
 {
+	RS_COMBAT_SCOPE(RsBattleLibrary_ApplyDamageEffectSpec);
+
 	UAbilitySystemComponent* SourceASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(SourceActor);
 	UAbilitySystemComponent* TargetASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(TargetActor);
 	
@@ -67,15 +125,12 @@ void URsBattleLibrary::ApplyDamageEffectSpec(AActor* SourceActor, AActor* Target
 	}
 }
 
-bool URsBattleLibrary::IsCriticalHitEffect(FGameplayEffectContextHandle& EffectContextHandle)
+bool URsBattleLibrary::IsCriticalHitEffect(const FGameplayEffectContextHandle& EffectContextHandle)
 {
-	if (FGameplayEffectContext* EffectContext = EffectContextHandle.Get())
+	const FGameplayEffectContext* EffectContext = EffectContextHandle.Get();
+	if (EffectContext && EffectContext->GetScriptStruct()->IsChildOf(FRsGameplayEffectContext::StaticStruct()))
 	{
-		if (EffectContext->GetScriptStruct() == FRsGameplayEffectContext::StaticStruct())
-		{
-			FRsGameplayEffectContext RsEffectContext = *static_cast<FRsGameplayEffectContext*>(EffectContextHandle.Get());
-			return RsEffectContext.bIsCriticalHit;
-		}
+		return static_cast<const FRsGameplayEffectContext*>(EffectContext)->bIsCriticalHit;
 	}
 	return false;
 }
@@ -22,12 +22,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "RS Battle Library")
 	static bool ExecuteTargeting(AActor* SourceActor, const UTargetingPreset* TargetingPreset, TArray<AActor*>& ResultActors);
 
+	// Same as ExecuteTargeting, but on the server other characters are rewound to where the source actor's remote client saw them.
+	UFUNCTION(BlueprintCallable, Category = "RS Battle Library")
+	static bool ExecuteLagCompensatedTargeting(AActor* SourceActor, const UTargetingPreset* TargetingPreset, TArray<AActor*>& ResultActors);
+
+	// Estimated server time that the remote client controlling the source actor is seeing. Returns current time for local or AI controlled actors.
+	UFUNCTION(BlueprintPure, Category = "RS Battle Library")
+	static double GetClientViewTime(const AActor* SourceActor);
+
 	UFUNCTION(BlueprintCallable, Category = "RS Battle Library")
 	static void ApplyDamageEffect(AActor* SourceActor, AActor* TargetActor, TSubclassOf<UGameplayEffect> GameplayEffectClass);
 
 	UFUNCTION(BlueprintCallable, Category = "RS Battle Library")
 	static void ApplyDamageEffectSpec(AActor* SourceActor, AActor* TargetActor, const FGameplayEffectSpecHandle& EffectHandle);
 
+	// Reads the flag in place. Called for every damage cue.
 	UFUNCTION(BlueprintPure, Category = "RS Ability System Library")
-	static bool IsCriticalHitEffect(UPARAM(ref)FGameplayEffectContextHandle& EffectContextHandle);
+	static bool IsCriticalHitEffect(const FGameplayEffectContextHandle& EffectContextHandle);
 };
@@ -0,0 +1,8 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsCombatStats.h"
+
+#if RS_COMBAT_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(RsCombatChannel);
+#endif
@@ -0,0 +1,26 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("RsCombat"), STATGROUP_RsCombat, STATCAT_Advanced);
+
+// Health set deaths and crowd entity kills.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deaths"), STAT_RsCombatDeaths, STATGROUP_RsCombat, RS_API);
+
+// Combat CPU events in Unreal Insights. Enable with -trace=cpu,RsCombat, or "Trace.Enable RsCombat" at runtime.
+#define RS_COMBAT_TRACE_ENABLED (CPUPROFILERTRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if RS_COMBAT_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(RsCombatChannel);
+#define RS_COMBAT_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, RsCombatChannel)
+#else
+#define RS_COMBAT_TRACE_SCOPE(Name)
+#endif
+
+// Cycle stat in STATGROUP_RsCombat and CPU event on the RsCombat trace channel for the rest of the scope. Both compile out in shipping.
+#define RS_COMBAT_SCOPE(Name) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_##Name, STATGROUP_RsCombat); \
+	RS_COMBAT_TRACE_SCOPE(Name)
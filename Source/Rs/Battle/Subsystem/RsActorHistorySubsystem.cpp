@@ -0,0 +1,216 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsActorHistorySubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+
+static TAutoConsoleVariable<bool> CVarRsLagCompensation(
+	TEXT("rs.LagCompensation"),
+	true,
+	TEXT("Rewind characters to the client's view time when the server evaluates hit detection for remote players."),
+	ECVF_Default);
+
+URsActorHistorySubsystem* URsActorHistorySubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsActorHistorySubsystem>();
+	}
+	return nullptr;
+}
+
+void URsActorHistorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SampleRate = FMath::Max(SampleRate, 1.f);
+	SampleCapacity = FMath::CeilToInt32(MaxHistoryTime * SampleRate) + 1;
+}
+
+bool URsActorHistorySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsActorHistorySubsystem::RegisterActor(AActor* Actor)
+{
+	if (Actor == nullptr || !Actor->HasAuthority())
+	{
+		return;
+	}
+	
+	FHistory& History = Histories.FindOrAdd(Actor);
+	History.Actor = Actor;
+	History.Samples.SetNum(SampleCapacity);
+	History.Head = INDEX_NONE;
+	History.Num = 0;
+}
+
+void URsActorHistorySubsystem::UnregisterActor(AActor* Actor)
+{
+	Histories.Remove(Actor);
+}
+
+bool URsActorHistorySubsystem::GetTransformAtTime(const AActor* Actor, double Timestamp, FTransform& OutTransform) const
+{
+	const FHistory* History = Histories.Find(Actor);
+	if (History == nullptr || History->Num == 0)
+	{
+		return false;
+	}
+
+	// Newer than the newest sample, the current transform is the best guess.
+	const FSample& Newest = History->GetFromNewest(0);
+	if (Timestamp >= Newest.Time)
+	{
+		OutTransform = Actor->GetActorTransform();
+		return true;
+	}
+	
+	for (int32 Offset = 1; Offset < History->Num; ++Offset)
+	{
+		const FSample& Older = History->GetFromNewest(Offset);
+		if (Older.Time <= Timestamp)
+		{
+			const FSample& Newer = History->GetFromNewest(Offset - 1);
+			const double Alpha = (Timestamp - Older.Time) / FMath::Max(Newer.Time - Older.Time, UE_SMALL_NUMBER);
+			OutTransform.SetLocation(FMath::Lerp(Older.Location, Newer.Location, Alpha));
+			OutTransform.SetRotation(FQuat::Slerp(Older.Rotation, Newer.Rotation, Alpha));
+			OutTransform.SetScale3D(Actor->GetActorScale3D());
+			return true;
+		}
+	}
+
+	// Older than the history, clamp to the oldest sample.
+	const FSample& Oldest = History->GetFromNewest(History->Num - 1);
+	OutTransform = FTransform(Oldest.Rotation, Oldest.Location, Actor->GetActorScale3D());
+	return true;
+}
+
+void URsActorHistorySubsystem::RewindActors(double Timestamp, const AActor* SourceActor)
+{
+	ensureMsgf(RewoundActors.IsEmpty(), TEXT("RsActorHistorySubsystem::RewindActors: Previous rewind was not restored"));
+	RestoreActors();
+
+	if (!CVarRsLagCompensation.GetValueOnGameThread())
+	{
+		return;
+	}
+	
+	const FVector Origin = SourceActor->GetActorLocation();
+	const float RadiusSquared = FMath::Square(RewindRadius);
+	for (const TPair<TObjectKey<AActor>, FHistory>& Pair : Histories)
+	{
+		AActor* Actor = Pair.Value.Actor.Get();
+		if (Actor == nullptr || Actor == SourceActor)
+		{
+			continue;
+		}
+		if (FVector::DistSquared(Actor->GetActorLocation(), Origin) > RadiusSquared)
+		{
+			continue;
+		}
+
+		// The history records the actor transform, which is the root component's.
+		UPrimitiveComponent* HitShape = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+		FBodyInstance* BodyInstance = HitShape ? HitShape->GetBodyInstance() : nullptr;
+		if (BodyInstance == nullptr || !BodyInstance->IsValidBodyInstance())
+		{
+			continue;
+		}
+
+		FTransform RewoundTransform;
+		if (GetTransformAtTime(Actor, Timestamp, RewoundTransform))
+		{
+			RewoundActors.Add({ HitShape });
+			BodyInstance->SetBodyTransform(RewoundTransform, ETeleportType::TeleportPhysics);
+		}
+	}
+}
+
+void URsActorHistorySubsystem::RestoreActors()
+{
+	for (const FRewoundActor& RewoundActor : RewoundActors)
+	{
+		// The component never moved, so its transform is where the body belongs.
+		UPrimitiveComponent* HitShape = RewoundActor.HitShape.Get();
+		if (FBodyInstance* BodyInstance = HitShape ? HitShape->GetBodyInstance() : nullptr)
+		{
+			BodyInstance->SetBodyTransform(HitShape->GetComponentTransform(), ETeleportType::TeleportPhysics);
+		}
+	}
+	RewoundActors.Reset();
+}
+
+double URsActorHistorySubsystem::GetOldestRewindTime() const
+{
+	return GetWorld()->GetTimeSeconds() - MaxHistoryTime;
+}
+
+void URsActorHistorySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now - LastSampleTime >= 1.0 / SampleRate)
+	{
+		RecordSamples(Now);
+		LastSampleTime = Now;
+	}
+}
+
+bool URsActorHistorySubsystem::IsTickable() const
+{
+	return !Histories.IsEmpty() && !IsTemplate();
+}
+
+TStatId URsActorHistorySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsActorHistorySubsystem, STATGROUP_Tickables);
+}
+
+void URsActorHistorySubsystem::RecordSamples(double Now)
+{
+	for (auto It = Histories.CreateIterator(); It; ++It)
+	{
+		FHistory& History = It.Value();
+		const AActor* Actor = History.Actor.Get();
+		if (Actor == nullptr)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		History.Add({ Now, Actor->GetActorLocation(), Actor->GetActorQuat() });
+	}
+}
+
+void URsActorHistorySubsystem::FHistory::Add(const FSample& Sample)
+{
+	Head = (Head + 1) % Samples.Num();
+	Samples[Head] = Sample;
+	Num = FMath::Min(Num + 1, Samples.Num());
+}
+
+const URsActorHistorySubsystem::FSample& URsActorHistorySubsystem::FHistory::GetFromNewest(int32 Offset) const
+{
+	check(Offset < Num);
+	return Samples[(Head - Offset + Samples.Num()) % Samples.Num()];
+}
+
+FRsScopedActorRewind::FRsScopedActorRewind(const AActor* SourceActor, double Timestamp)
+{
+	if (URsActorHistorySubsystem* HistorySubsystem = URsActorHistorySubsystem::Get(SourceActor))
+	{
+		Subsystem = HistorySubsystem;
+		HistorySubsystem->RewindActors(Timestamp, SourceActor);
+	}
+}
+
+FRsScopedActorRewind::~FRsScopedActorRewind()
+{
+	if (URsActorHistorySubsystem* HistorySubsystem = Subsystem.Get())
+	{
+		HistorySubsystem->RestoreActors();
+	}
+}
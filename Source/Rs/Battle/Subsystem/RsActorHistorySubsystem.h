@@ -0,0 +1,103 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RsActorHistorySubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Records recent transforms of registered actors on the server, so that hit detection can be evaluated where a remote client saw them.
+ * All actors are sampled together at a fixed rate into fixed size ring buffers, which keeps memory per actor bounded and cost low with many characters.
+ */
+UCLASS(Config = Game)
+class RS_API URsActorHistorySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsActorHistorySubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void RegisterActor(AActor* Actor);
+	void UnregisterActor(AActor* Actor);
+
+	// Returns the interpolated transform of the actor at the given server time. Returns false if the actor has no history.
+	bool GetTransformAtTime(const AActor* Actor, double Timestamp, FTransform& OutTransform) const;
+
+	// Moves the hit-test shape of every recorded actor near the source actor to where it was at the given time. Must be followed by RestoreActors().
+	// Only the physics body of the root primitive moves, for scene queries. Actors and components stay in place, so no overlap or movement events fire.
+	void RewindActors(double Timestamp, const AActor* SourceActor);
+	void RestoreActors();
+
+	// Oldest time that can be rewound to.
+	double GetOldestRewindTime() const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FSample
+	{
+		double Time = 0.0;
+		FVector Location = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+	};
+
+	struct FHistory
+	{
+		TWeakObjectPtr<AActor> Actor;
+		
+		// Ring buffer, Samples[Head] is the newest sample.
+		TArray<FSample> Samples;
+		int32 Head = INDEX_NONE;
+		int32 Num = 0;
+
+		void Add(const FSample& Sample);
+		const FSample& GetFromNewest(int32 Offset) const;
+	};
+
+	struct FRewoundActor
+	{
+		TWeakObjectPtr<UPrimitiveComponent> HitShape;
+	};
+
+	void RecordSamples(double Now);
+	
+	// Samples per second.
+	UPROPERTY(Config)
+	float SampleRate = 30.f;
+
+	// How far back in time can be rewound. Clients with higher latency are clamped to this.
+	UPROPERTY(Config)
+	float MaxHistoryTime = 0.5f;
+
+	// Only actors within this distance from the source actor are rewound.
+	UPROPERTY(Config)
+	float RewindRadius = 2000.f;
+
+	int32 SampleCapacity = 0;
+	double LastSampleTime = 0.0;
+	
+	TMap<TObjectKey<AActor>, FHistory> Histories;
+	TArray<FRewoundActor> RewoundActors;
+};
+
+/**
+ * Rewinds recorded actors for the lifetime of the scope.
+ */
+struct RS_API FRsScopedActorRewind
+{
+	FRsScopedActorRewind(const AActor* SourceActor, double Timestamp);
+	~FRsScopedActorRewind();
+
+private:
+	TWeakObjectPtr<URsActorHistorySubsystem> Subsystem;
+};
@@ -0,0 +1,150 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsProjectilePredictionSubsystem.h"
+
+#include "Rs/Battle/Actor/RsProjectile.h"
+
+DECLARE_STATS_GROUP(TEXT("RsProjectile"), STATGROUP_RsProjectile, STATCAT_Advanced);
+// Totals since start, divide by the count for the average.
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Time To First Visual Total (ms)"), STAT_RsProjectileTimeToFirstVisual, STATGROUP_RsProjectile);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Time To First Visual Count"), STAT_RsProjectileTimeToFirstVisualCount, STATGROUP_RsProjectile);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Server Projectile Arrival Total (ms)"), STAT_RsProjectileServerArrival, STATGROUP_RsProjectile);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Server Projectile Arrival Count"), STAT_RsProjectileServerArrivalCount, STATGROUP_RsProjectile);
+
+static TAutoConsoleVariable<bool> CVarRsPredictProjectiles(
+	TEXT("rs.Projectile.Predict"),
+	true,
+	TEXT("Spawn cosmetic projectiles on the owning client before the server projectile arrives."),
+	ECVF_Default);
+
+// Fires that never get a server projectile are dropped after this time.
+static constexpr double PredictedFireTimeout = 2.0;
+
+URsProjectilePredictionSubsystem* URsProjectilePredictionSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsProjectilePredictionSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsProjectilePredictionSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only owning clients predict, the server always spawns the real projectile.
+	return Super::ShouldCreateSubsystem(Outer) && !IsRunningDedicatedServer();
+}
+
+bool URsProjectilePredictionSubsystem::IsPredictionEnabled()
+{
+	return CVarRsPredictProjectiles.GetValueOnGameThread();
+}
+
+int32 URsProjectilePredictionSubsystem::MakePredictionId(int16 PredictionKey, int32 FireIndex)
+{
+	if (PredictionKey <= 0)
+	{
+		return INDEX_NONE;
+	}
+	return (static_cast<int32>(PredictionKey) << 8) | (FireIndex & 0xFF);
+}
+
+void URsProjectilePredictionSubsystem::RegisterPredictedFire(const AActor* Instigator, int32 PredictionId, ARsProjectile* CosmeticProjectile)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	PredictedFires.RemoveAllSwap([Now](const FPredictedFire& PredictedFire)
+	{
+		return Now - PredictedFire.FireTime > PredictedFireTimeout;
+	});
+
+	if (PredictionId == INDEX_NONE)
+	{
+		return;
+	}
+	
+	FPredictedFire& NewFire = PredictedFires.AddDefaulted_GetRef();
+	NewFire.Instigator = Instigator;
+	NewFire.PredictionId = PredictionId;
+	NewFire.CosmeticProjectile = CosmeticProjectile;
+	NewFire.FireTime = Now;
+	NewFire.FirePlatformTime = FPlatformTime::Seconds();
+
+	if (CosmeticProjectile)
+	{
+		NewFire.bPredicted = true;
+		WatchFirstVisual(CosmeticProjectile, NewFire);
+	}
+}
+
+void URsProjectilePredictionSubsystem::ReconcileProjectile(ARsProjectile* ServerProjectile)
+{
+	const int32 FireIndex = PredictedFires.IndexOfByPredicate([ServerProjectile](const FPredictedFire& PredictedFire)
+	{
+		return PredictedFire.PredictionId == ServerProjectile->PredictionId && PredictedFire.Instigator == ServerProjectile->GetInstigator();
+	});
+	if (FireIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FPredictedFire PredictedFire = PredictedFires[FireIndex];
+	PredictedFires.RemoveAtSwap(FireIndex);
+	
+	INC_FLOAT_STAT_BY(STAT_RsProjectileServerArrival, (GetWorld()->GetTimeSeconds() - PredictedFire.FireTime) * 1000.0);
+	INC_DWORD_STAT(STAT_RsProjectileServerArrivalCount);
+	
+	if (ARsProjectile* CosmeticProjectile = PredictedFire.CosmeticProjectile.Get())
+	{
+		// Keep the cosmetic projectile which is already ahead, and hide the server one.
+		ServerProjectile->LinkCosmeticProjectile(CosmeticProjectile);
+	}
+	else if (!PredictedFire.bPredicted)
+	{
+		// Not predicted, the server projectile is the first visual.
+		WatchFirstVisual(ServerProjectile, PredictedFire);
+	}
+}
+
+void URsProjectilePredictionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Last render time is only written by the renderer, so the first visual is noticed on the frame after it was drawn.
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double NowPlatformTime = FPlatformTime::Seconds();
+	PendingVisuals.RemoveAllSwap([Now, NowPlatformTime](const FPendingVisual& PendingVisual)
+	{
+		const ARsProjectile* Projectile = PendingVisual.Projectile.Get();
+		if (Projectile == nullptr || Now - PendingVisual.FireTime > PredictedFireTimeout)
+		{
+			return true;
+		}
+		if (Projectile->GetLastRenderTime() < PendingVisual.FireTime)
+		{
+			return false;
+		}
+
+		INC_FLOAT_STAT_BY(STAT_RsProjectileTimeToFirstVisual, (NowPlatformTime - PendingVisual.FirePlatformTime) * 1000.0);
+		INC_DWORD_STAT(STAT_RsProjectileTimeToFirstVisualCount);
+		return true;
+	});
+}
+
+bool URsProjectilePredictionSubsystem::IsTickable() const
+{
+	return !PendingVisuals.IsEmpty();
+}
+
+TStatId URsProjectilePredictionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsProjectilePredictionSubsystem, STATGROUP_Tickables);
+}
+
+void URsProjectilePredictionSubsystem::WatchFirstVisual(ARsProjectile* Projectile, const FPredictedFire& PredictedFire)
+{
+	FPendingVisual& PendingVisual = PendingVisuals.AddDefaulted_GetRef();
+	PendingVisual.Projectile = Projectile;
+	PendingVisual.FireTime = PredictedFire.FireTime;
+	PendingVisual.FirePlatformTime = PredictedFire.FirePlatformTime;
+}
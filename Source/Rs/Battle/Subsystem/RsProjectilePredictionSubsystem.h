@@ -0,0 +1,67 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsProjectilePredictionSubsystem.generated.h"
+
+class ARsProjectile;
+
+/**
+ * Matches server projectiles with the cosmetic projectiles that the owning client spawned in advance.
+ * The cosmetic projectile stays visible and the server projectile is hidden on the owning client, so there is only one visual and only the server projectile deals damage.
+ * Also measures time from fire until the first projectile is rendered, for predicted and unpredicted fires alike.
+ */
+UCLASS()
+class RS_API URsProjectilePredictionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsProjectilePredictionSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	static bool IsPredictionEnabled();
+
+	// Makes an ID that is the same on the server and the predicting client.
+	static int32 MakePredictionId(int16 PredictionKey, int32 FireIndex);
+
+	// Called on the owning client when it fires. CosmeticProjectile can be null if prediction is disabled.
+	void RegisterPredictedFire(const AActor* Instigator, int32 PredictionId, ARsProjectile* CosmeticProjectile);
+
+	// Called on the owning client when the server projectile arrives.
+	void ReconcileProjectile(ARsProjectile* ServerProjectile);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FPredictedFire
+	{
+		TWeakObjectPtr<const AActor> Instigator;
+		int32 PredictionId = INDEX_NONE;
+		TWeakObjectPtr<ARsProjectile> CosmeticProjectile;
+		double FireTime = 0.0;
+		double FirePlatformTime = 0.0;
+
+		// The cosmetic projectile is the first visual of this fire, even if it is gone when the server projectile arrives.
+		bool bPredicted = false;
+	};
+
+	// Projectile that will be the first visual of a fire, waiting for its first render.
+	struct FPendingVisual
+	{
+		TWeakObjectPtr<ARsProjectile> Projectile;
+		double FireTime = 0.0;
+		double FirePlatformTime = 0.0;
+	};
+
+	void WatchFirstVisual(ARsProjectile* Projectile, const FPredictedFire& PredictedFire);
+
+	TArray<FPredictedFire> PredictedFires;
+	TArray<FPendingVisual> PendingVisuals;
+};
@@ -0,0 +1,141 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsWeaponTraceSubsystem.h"
+
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Components/MeshComponent.h"
+#include "Rs/AI/RsAILibrary.h"
+#include "Rs/Battle/Actor/RsWeapon.h"
+
+URsWeaponTraceSubsystem* URsWeaponTraceSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsWeaponTraceSubsystem>();
+	}
+	return nullptr;
+}
+
+void URsWeaponTraceSubsystem::BeginSwing(const UObject* SwingOwner, ARsWeapon* Weapon, AActor* Instigator, const FRsWeaponTraceParams& Params)
+{
+	if (SwingOwner == nullptr || Weapon == nullptr || Instigator == nullptr || Weapon->GetTraceMeshComponent() == nullptr)
+	{
+		return;
+	}
+
+	// Restart the swing if it is already active. (e.g. looping montage section)
+	EndSwing(SwingOwner, Weapon);
+	
+	FSwing& NewSwing = ActiveSwings.AddDefaulted_GetRef();
+	NewSwing.SwingOwner = SwingOwner;
+	NewSwing.Weapon = Weapon;
+	NewSwing.MeshComponent = Weapon->GetTraceMeshComponent();
+	NewSwing.Instigator = Instigator;
+	NewSwing.Params = Params;
+	NewSwing.Params.SubSteps = FMath::Max(Params.SubSteps, 1);
+	NewSwing.Radius = Weapon->TraceRadius;
+	NewSwing.PrevTransform = NewSwing.MeshComponent->GetComponentTransform();
+	Weapon->GetTraceSocketLocalLocations(NewSwing.SocketLocalLocations);
+}
+
+void URsWeaponTraceSubsystem::EndSwing(const UObject* SwingOwner, const ARsWeapon* Weapon)
+{
+	ActiveSwings.RemoveAllSwap([SwingOwner, Weapon](const FSwing& Swing)
+	{
+		return Swing.SwingOwner == SwingOwner && Swing.Weapon == Weapon;
+	});
+}
+
+void URsWeaponTraceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	PendingHits.Reset();
+	
+	for (int32 Index = ActiveSwings.Num() - 1; Index >= 0; --Index)
+	{
+		FSwing& Swing = ActiveSwings[Index];
+		if (!Swing.SwingOwner.IsValid() || !Swing.MeshComponent.IsValid() || !Swing.Instigator.IsValid())
+		{
+			ActiveSwings.RemoveAtSwap(Index);
+			continue;
+		}
+		SweepSwing(Swing, PendingHits);
+	}
+
+	// Send hit events after all sweeps are done, because abilities can end swings while handling them.
+	for (const FPendingHit& PendingHit : PendingHits)
+	{
+		AActor* Instigator = PendingHit.Instigator.Get();
+		if (Instigator == nullptr)
+		{
+			continue;
+		}
+		
+		FGameplayEventData Payload;
+		Payload.EventTag = PendingHit.HitEventTag;
+		Payload.Instigator = Instigator;
+		Payload.Target = PendingHit.HitResult.GetActor();
+		Payload.TargetData = UAbilitySystemBlueprintLibrary::AbilityTargetDataFromHitResult(PendingHit.HitResult);
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(Instigator, PendingHit.HitEventTag, Payload);
+	}
+}
+
+bool URsWeaponTraceSubsystem::IsTickable() const
+{
+	return !ActiveSwings.IsEmpty();
+}
+
+TStatId URsWeaponTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsWeaponTraceSubsystem, STATGROUP_Tickables);
+}
+
+void URsWeaponTraceSubsystem::SweepSwing(FSwing& Swing, TArray<FPendingHit>& OutHits)
+{
+	AActor* Instigator = Swing.Instigator.Get();
+	const FTransform CurrentTransform = Swing.MeshComponent->GetComponentTransform();
+	const FCollisionShape SweepShape = FCollisionShape::MakeSphere(Swing.Radius);
+	
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RsWeaponTrace), false, Instigator);
+	QueryParams.AddIgnoredActor(Swing.Weapon.Get());
+
+	const uint8 InstigatorTeamID = URsAILibrary::GetTeamID(Instigator);
+	
+	// Blend the whole transform rather than socket positions, so sub-steps follow the arc of the swing.
+	FTransform StepStartTransform = Swing.PrevTransform;
+	for (int32 Step = 1; Step <= Swing.Params.SubSteps; ++Step)
+	{
+		FTransform StepEndTransform;
+		StepEndTransform.Blend(Swing.PrevTransform, CurrentTransform, static_cast<float>(Step) / Swing.Params.SubSteps);
+		
+		for (const FVector& SocketLocalLocation : Swing.SocketLocalLocations)
+		{
+			const FVector Start = StepStartTransform.TransformPosition(SocketLocalLocation);
+			const FVector End = StepEndTransform.TransformPosition(SocketLocalLocation);
+
+			SweepResults.Reset();
+			GetWorld()->SweepMultiByChannel(SweepResults, Start, End, FQuat::Identity, Swing.Params.TraceChannel, SweepShape, QueryParams);
+			
+			for (const FHitResult& Result : SweepResults)
+			{
+				AActor* HitActor = Result.GetActor();
+				if (HitActor == nullptr || Swing.HitActors.Contains(HitActor))
+				{
+					continue;
+				}
+				if (Swing.Params.bCannotHitFriend && URsAILibrary::GetTeamID(HitActor) == InstigatorTeamID)
+				{
+					continue;
+				}
+				
+				Swing.HitActors.Add(HitActor);
+				OutHits.Add({ Swing.Instigator, Swing.Params.HitEventTag, Result });
+			}
+		}
+		StepStartTransform = StepEndTransform;
+	}
+	
+	Swing.PrevTransform = CurrentTransform;
+}
@@ -0,0 +1,85 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsWeaponTraceSubsystem.generated.h"
+
+class ARsWeapon;
+class UMeshComponent;
+
+// Parameters of a single weapon swing, usually filled by an anim notify state.
+USTRUCT(BlueprintType)
+struct FRsWeaponTraceParams
+{
+	GENERATED_BODY()
+
+	// Gameplay event sent to the weapon owner for each actor hit by the swing.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Categories = "Event"))
+	FGameplayTag HitEventTag;
+
+	// Number of interpolated sweeps between two frames. Higher values follow curved swings more closely at low frame rates.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1", ClampMax = "16"))
+	int32 SubSteps = 3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Pawn;
+
+	// Ignore actors on the same team as the weapon owner.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCannotHitFriend = true;
+};
+
+/**
+ * Sweeps the trace sockets of every active weapon swing in one pass per frame.
+ * Socket positions are interpolated between the previous and current weapon transform, so fast swings don't skip targets at low frame rates.
+ * Each victim is reported once per swing to the weapon owner as a gameplay event, which feeds the melee ability's damage path.
+ */
+UCLASS()
+class RS_API URsWeaponTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsWeaponTraceSubsystem* Get(const UObject* WorldContextObject);
+	
+	// Starts tracing the weapon. SwingOwner identifies the swing so that it can be stopped later, Instigator receives the hit events.
+	void BeginSwing(const UObject* SwingOwner, ARsWeapon* Weapon, AActor* Instigator, const FRsWeaponTraceParams& Params);
+	void EndSwing(const UObject* SwingOwner, const ARsWeapon* Weapon);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FSwing
+	{
+		TWeakObjectPtr<const UObject> SwingOwner;
+		TWeakObjectPtr<ARsWeapon> Weapon;
+		TWeakObjectPtr<UMeshComponent> MeshComponent;
+		TWeakObjectPtr<AActor> Instigator;
+		FRsWeaponTraceParams Params;
+		float Radius = 0.f;
+		TArray<FVector> SocketLocalLocations;
+		FTransform PrevTransform;
+		TSet<TWeakObjectPtr<AActor>> HitActors;
+	};
+
+	struct FPendingHit
+	{
+		TWeakObjectPtr<AActor> Instigator;
+		FGameplayTag HitEventTag;
+		FHitResult HitResult;
+	};
+
+	void SweepSwing(FSwing& Swing, TArray<FPendingHit>& OutHits);
+
+	TArray<FSwing> ActiveSwings;
+
+	// Reused every frame to avoid reallocations.
+	TArray<FPendingHit> PendingHits;
+	TArray<FHitResult> SweepResults;
+};
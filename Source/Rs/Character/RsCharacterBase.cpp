@@ -5,6 +5,8 @@
 
 #include "Net/UnrealNetwork.h"
 #include "Rs/AbilitySystem/Component/RsAbilitySystemComponent.h"
+#include "Rs/Battle/Subsystem/RsActorHistorySubsystem.h"
+#include "Rs/System/RsSignificanceSubsystem.h"
 
 void ARsCharacterBase::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const
 {
@@ -13,6 +15,36 @@ void ARsCharacterBase::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& O
 	DOREPLIFETIME(ThisClass, TeamID);
 }
 
+void ARsCharacterBase::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Record transform history for lag compensated hit detection.
+	if (URsActorHistorySubsystem* ActorHistorySubsystem = URsActorHistorySubsystem::Get(this))
+	{
+		ActorHistorySubsystem->RegisterActor(this);
+	}
+
+	if (URsSignificanceSubsystem* SignificanceSubsystem = URsSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->RegisterCharacter(this);
+	}
+}
+
+void ARsCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (URsActorHistorySubsystem* ActorHistorySubsystem = URsActorHistorySubsystem::Get(this))
+	{
+		ActorHistorySubsystem->UnregisterActor(this);
+	}
+	if (URsSignificanceSubsystem* SignificanceSubsystem = URsSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->UnregisterCharacter(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 UAbilitySystemComponent* ARsCharacterBase::GetAbilitySystemComponent() const
 {
 	return AbilitySystemComponent;
@@ -26,14 +26,19 @@ public:
 	UFUNCTION(BlueprintImplementableEvent)
 	void PostInitializeAbilitySystem();
 
+	// Native counterpart of PostInitializeAbilitySystem.
+	FSimpleMulticastDelegate OnAbilitySystemInitialized;
+
 	// IGenericTeamAgentInterface
 	virtual void SetGenericTeamId(const FGenericTeamId& InTeamID) override { TeamID = InTeamID; }
 	virtual FGenericTeamId GetGenericTeamId() const override { return TeamID; }
 
 protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
 	// Creates a pointer to the Ability System Component associated with this Character.
-	// Player Characters will set this in OnRep_PlayerState() locally, and in OnPossessed() server side.
-	// Non Player Characters will set this in its constructor.
+	// Set in the constructor. Player Characters own theirs too, so it stays with the party member across possession changes.
 	UPROPERTY()
 	TObjectPtr<URsAbilitySystemComponent> AbilitySystemComponent;
 
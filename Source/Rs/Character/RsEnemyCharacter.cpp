@@ -26,6 +26,7 @@ void ARsEnemyCharacter::PostInitializeComponents()
 		AbilitySystemComponent->InitializeAbilitySystem(AbilitySet, this, this);
 		HealthComponent->Initialize(AbilitySystemComponent);
 		PostInitializeAbilitySystem();
+		OnAbilitySystemInitialized.Broadcast();
 	}
 }
 
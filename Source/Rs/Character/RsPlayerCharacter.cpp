@@ -3,16 +3,19 @@
 
 #include "RsPlayerCharacter.h"
 
-#include "AbilitySystemGlobals.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputMappingContext.h"
 #include "Camera/CameraComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/PawnMovementComponent.h"
-#include "GameFramework/PlayerState.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Rs/AI/AIController/RsAIControllerBase.h"
 #include "Rs/AbilitySystem/Component/RsAbilitySystemComponent.h"
 #include "Rs/AbilitySystem/Component/RsHealthComponent.h"
+#include "Rs/Party/RsPartyComponent.h"
 #include "Rs/Party/RsPartyLibrary.h"
 
 ARsPlayerCharacter::ARsPlayerCharacter()
@@ -26,6 +29,11 @@ ARsPlayerCharacter::ARsPlayerCharacter()
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
 	FollowCamera->bUsePawnControlRotation = false;
 
+	// Each party member owns its ability system, so granted abilities, effects and attributes stay with the character across party switches.
+	AbilitySystemComponent = CreateDefaultSubobject<URsAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+	// This will replicate minimal Gameplay Effects to Simulated Proxies and full info to the owning client.
+	AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Mixed);
+
 	HealthComponent = CreateDefaultSubobject<URsHealthComponent>(TEXT("HealthComponent"));
 
 	// Team ID "0" is for player.
@@ -38,7 +46,9 @@ void ARsPlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputC
 
 	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
 	{
-		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
+		// Party members usually share the mapping context. Adding it again rebuilds the player's key mappings.
+		UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer());
+		if (Subsystem && !Subsystem->HasMappingContext(DefaultMappingContext))
 		{
 			Subsystem->AddMappingContext(DefaultMappingContext, 0);
 		}
@@ -51,6 +61,24 @@ void ARsPlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputC
 	}
 }
 
+void ARsPlayerCharacter::DestroyPlayerInputComponent()
+{
+	// Benched party members keep their bindings. The input component is only processed while a player controller possesses this pawn.
+	if (URsPartyComponent::IsPrewarmedSwitchEnabled() && !IsActorBeingDestroyed())
+	{
+		return;
+	}
+	
+	Super::DestroyPlayerInputComponent();
+}
+
+void ARsPlayerCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	InitAbilitySystem();
+}
+
 void ARsPlayerCharacter::BeginPlay()
 {
 	Super::BeginPlay();
@@ -59,12 +87,39 @@ void ARsPlayerCharacter::BeginPlay()
 	URsPartyLibrary::AddPartyMember(this);
 }
 
+void ARsPlayerCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Frees the slot. The other members keep theirs.
+	if (EndPlayReason == EEndPlayReason::Destroyed)
+	{
+		URsPartyLibrary::RemovePartyMember(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARsPlayerCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ThisClass, bDormant);
+}
+
 void ARsPlayerCharacter::PossessedBy(AController* NewController)
 {
 	Super::PossessedBy(NewController);
 
-	// Server side
-	InitAbilitySystem();
+	// Switched in.
+	if (bDormant && NewController && NewController->IsPlayerController())
+	{
+		SetDormant(false);
+	}
+
+	// Server side. Granted data stays, only the cached controller changes.
+	if (AbilitySystemComponent)
+	{
+		AbilitySystemComponent->RefreshAbilityActorInfo();
+	}
 }
 
 void ARsPlayerCharacter::UnPossessed()
@@ -74,25 +129,77 @@ void ARsPlayerCharacter::UnPossessed()
 	GetMovementComponent()->StopMovementImmediately();
 }
 
-void ARsPlayerCharacter::OnRep_PlayerState()
+void ARsPlayerCharacter::OnRep_Controller()
 {
-	Super::OnRep_PlayerState();
+	Super::OnRep_Controller();
 
-	// Client side
-	InitAbilitySystem();
+	// Client side. Local prediction needs the new player controller in the actor info.
+	if (AbilitySystemComponent)
+	{
+		AbilitySystemComponent->RefreshAbilityActorInfo();
+	}
 }
 
 void ARsPlayerCharacter::InitAbilitySystem()
 {
-	AbilitySystemComponent = Cast<URsAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetPlayerState()));
+	// The Ability System Component is created in the class constructor, so it should always be valid at this point.
 	if (AbilitySystemComponent)
 	{
-		AbilitySystemComponent->InitializeAbilitySystem(AbilitySet, GetPlayerState(), this);
+		AbilitySystemComponent->InitializeAbilitySystem(AbilitySet, this, this);
 		HealthComponent->Initialize(AbilitySystemComponent);
 		PostInitializeAbilitySystem();
+		OnAbilitySystemInitialized.Broadcast();
 	}
 }
 
+void ARsPlayerCharacter::SetDormant(bool bNewDormant)
+{
+	if (bDormant == bNewDormant)
+	{
+		return;
+	}
+	bDormant = bNewDormant;
+
+	if (ARsAIControllerBase* AIController = Cast<ARsAIControllerBase>(GetController()))
+	{
+		AIController->SetDormant(bDormant);
+	}
+
+	// The ability system belongs to this character, so suspended effects survive the possession swap of a switch.
+	// Cooldowns are effect durations, so they keep running without any work here.
+	if (AbilitySystemComponent)
+	{
+		if (bDormant)
+		{
+			AbilitySystemComponent->CancelAllAbilities();
+			AbilitySystemComponent->SuspendPeriodicEffects();
+		}
+		else
+		{
+			AbilitySystemComponent->ResumePeriodicEffects();
+		}
+	}
+
+	ApplyDormancy();
+}
+
+void ARsPlayerCharacter::OnRep_Dormant()
+{
+	ApplyDormancy();
+}
+
+void ARsPlayerCharacter::ApplyDormancy()
+{
+	SetActorHiddenInGame(bDormant);
+	SetActorEnableCollision(!bDormant);
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetComponentTickEnabled(!bDormant);
+
+	GetMesh()->bPauseAnims = bDormant;
+	GetMesh()->SetComponentTickEnabled(!bDormant);
+}
+
 void ARsPlayerCharacter::HandleMove(const FInputActionValue& Value)
 {
 	FVector2D MovementVector = Value.Get<FVector2D>();
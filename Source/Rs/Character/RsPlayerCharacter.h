@@ -40,21 +40,39 @@ class RS_API ARsPlayerCharacter : public ARsCharacterBase
 	
 public:
 	ARsPlayerCharacter();
+
+	// Dormant party members are hidden and skip movement, AI and animation. Periodic regeneration catches up when they wake.
+	void SetDormant(bool bNewDormant);
+	bool IsDormant() const { return bDormant; }
+
+	URsHealthComponent* GetHealthComponent() const { return HealthComponent; }
 	
 protected:
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+	virtual void DestroyPlayerInputComponent() override;
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Called on the server to acknowledge possession of this Character.
 	virtual void PossessedBy(AController* NewController) override;
 	virtual void UnPossessed() override;
 
-	// Called on the client when the Character is assigned its Player State.
-	virtual void OnRep_PlayerState() override;
+	// Called on the client when the Character is assigned its Controller.
+	virtual void OnRep_Controller() override;
 
 	void InitAbilitySystem();
 
+	UFUNCTION()
+	void OnRep_Dormant();
+
 private:
+	UPROPERTY(ReplicatedUsing = OnRep_Dormant)
+	bool bDormant = false;
+
+	// Presentation and local simulation part of dormancy. Runs on every net mode.
+	void ApplyDormancy();
+
 	void HandleMove(const FInputActionValue& Value);
 	void HandleLook(const FInputActionValue& Value);
 };
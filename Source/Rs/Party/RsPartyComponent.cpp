@@ -3,20 +3,130 @@
 
 #include "RsPartyComponent.h"
 
+#include "Containers/Ticker.h"
+#include "Net/UnrealNetwork.h"
+#include "Rs/AbilitySystem/Component/RsHealthComponent.h"
 #include "Rs/Character/RsPlayerCharacter.h"
 #include "Rs/Player/RsPlayerController.h"
 
+DECLARE_STATS_GROUP(TEXT("RsParty"), STATGROUP_RsParty, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Switch Party Member"), STAT_RsPartySwitch, STATGROUP_RsParty);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Last Switch Latency (ms)"), STAT_RsPartySwitchLatency, STATGROUP_RsParty);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Switches"), STAT_RsPartySwitches, STATGROUP_RsParty);
+
+static TAutoConsoleVariable<bool> CVarRsPartyPrewarmedSwitch(
+	TEXT("rs.Party.PrewarmedSwitch"),
+	true,
+	TEXT("Benched party members keep their input bindings and view models between switches."));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRsPartySwitchBenchmark(
+	TEXT("rs.Party.SwitchBenchmark"),
+	TEXT("rs.Party.SwitchBenchmark [Count]. Switches to the next party member every frame and logs frame time and switch latency. (Default 100)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		ARsPlayerController* PlayerController = World ? Cast<ARsPlayerController>(World->GetFirstPlayerController()) : nullptr;
+		if (PlayerController == nullptr || !PlayerController->HasAuthority() || PlayerController->GetPartyComponent()->GetPartySlotCount() < 2)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("rs.Party.SwitchBenchmark: Needs an authoritative player controller with at least two party members"));
+			return;
+		}
+
+		struct FBenchmarkState
+		{
+			TWeakObjectPtr<ARsPlayerController> PlayerController;
+			int32 Remaining = 0;
+			int32 Count = 0;
+			double FrameTimeSum = 0.0;
+			double FrameTimeMax = 0.0;
+			double LatencySum = 0.0;
+			double LatencyMax = 0.0;
+		};
+		TSharedRef<FBenchmarkState> State = MakeShared<FBenchmarkState>();
+		State->PlayerController = PlayerController;
+		State->Remaining = Args.IsValidIndex(0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+		State->Count = State->Remaining;
+
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([State](float DeltaTime)
+		{
+			ARsPlayerController* PlayerController = State->PlayerController.Get();
+			if (PlayerController == nullptr)
+			{
+				return false;
+			}
+
+			// The first delta covers the frame the command ran in.
+			if (State->Remaining < State->Count)
+			{
+				State->FrameTimeSum += DeltaTime;
+				State->FrameTimeMax = FMath::Max<double>(State->FrameTimeMax, DeltaTime);
+			}
+
+			if (State->Remaining == 0)
+			{
+				UE_LOG(LogTemp, Log, TEXT("rs.Party.SwitchBenchmark: %d switches. Frame avg %.2f ms, max %.2f ms. Switch avg %.3f ms, max %.3f ms"),
+					State->Count, State->FrameTimeSum * 1000.0 / State->Count, State->FrameTimeMax * 1000.0,
+					State->LatencySum / State->Count, State->LatencyMax);
+				return false;
+			}
+
+			// Next occupied slot after the active one.
+			URsPartyComponent* PartyComponent = PlayerController->GetPartyComponent();
+			const int32 SlotCount = PartyComponent->GetPartySlotCount();
+			int32 NextSlot = PartyComponent->GetActiveMemberIndex();
+			do
+			{
+				NextSlot = (NextSlot + 1) % SlotCount;
+			}
+			while (PartyComponent->GetPartySlot(NextSlot) == nullptr);
+			PartyComponent->SwitchPartyMember(PlayerController, NextSlot);
+			State->LatencySum += PartyComponent->GetLastSwitchLatency();
+			State->LatencyMax = FMath::Max<double>(State->LatencyMax, PartyComponent->GetLastSwitchLatency());
+			--State->Remaining;
+			return true;
+		}));
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRsPartyDormant(
+	TEXT("rs.Party.Dormant"),
+	TEXT("rs.Party.Dormant <0/1>. Puts the party members the first player doesn't control to sleep, or wakes them up."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const ARsPlayerController* PlayerController = World ? Cast<ARsPlayerController>(World->GetFirstPlayerController()) : nullptr;
+		if (PlayerController == nullptr || !PlayerController->HasAuthority() || Args.Num() < 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("rs.Party.Dormant: Needs an authoritative player controller and 0 or 1"));
+			return;
+		}
+		PlayerController->GetPartyComponent()->SetDormantInactiveMembers(FCString::Atoi(*Args[0]) != 0);
+	}));
+
 URsPartyComponent::URsPartyComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
 	SetIsReplicatedByDefault(true);
+
+	Roster.Owner = this;
 }
 
-ARsPlayerCharacter* URsPartyComponent::GetPartyMember(int32 MemberIndex) const
+void URsPartyComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
-	if (PartyMembers.IsValidIndex(MemberIndex))
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ThisClass, Roster);
+}
+
+FRsPrewarmPartyMember URsPartyComponent::OnPrewarmPartyMember;
+
+bool URsPartyComponent::IsPrewarmedSwitchEnabled()
+{
+	return CVarRsPartyPrewarmedSwitch.GetValueOnGameThread();
+}
+
+ARsPlayerCharacter* URsPartyComponent::GetPartyMember(int32 SlotIndex) const
+{
+	if (const FRsPartySlot* Slot = Roster.FindSlot(SlotIndex))
 	{
-		return PartyMembers[MemberIndex];
+		return Slot->Character;
 	}
 	else
 	{
@@ -25,11 +135,44 @@ ARsPlayerCharacter* URsPartyComponent::GetPartyMember(int32 MemberIndex) const
 	}
 }
 
+const FRsPartySlot* URsPartyComponent::GetPartySlot(int32 SlotIndex) const
+{
+	return Roster.FindSlot(SlotIndex);
+}
+
+int32 URsPartyComponent::FindPartyMemberSlot(const ARsPlayerCharacter* Member) const
+{
+	return Roster.FindSlotIndex(Member);
+}
+
+int32 URsPartyComponent::GetPartySlotCount() const
+{
+	return Roster.GetSlotCount();
+}
+
 void URsPartyComponent::AddPartyMember(ARsPlayerCharacter* NewMember)
 {
-	if (!PartyMembers.Contains(NewMember))
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+	
+	if (FRsPartySlot* NewSlot = Roster.AddMember(NewMember))
 	{
-		PartyMembers.Add(NewMember);
+		// Build the member's view model now, not on the frame it gets switched in.
+		PrewarmSlot(*NewSlot);
+
+		if (URsHealthComponent* HealthComponent = NewMember->GetHealthComponent())
+		{
+			HealthComponent->OnHealthChanged.AddDynamic(this, &ThisClass::HandleMemberHealthChanged);
+		}
+
+		if (bDormantInactiveMembers && !NewMember->IsPlayerControlled())
+		{
+			SetMemberDormant(*NewSlot, true);
+		}
+		RefreshSlotFlags();
+		OnPartyRosterChanged.Broadcast();
 	}
 	else
 	{
@@ -39,9 +182,23 @@ void URsPartyComponent::AddPartyMember(ARsPlayerCharacter* NewMember)
 
 void URsPartyComponent::RemovePartyMember(ARsPlayerCharacter* MemberToRemove)
 {
-	if (PartyMembers.Contains(MemberToRemove))
+	if (!GetOwner()->HasAuthority())
 	{
-		PartyMembers.Remove(MemberToRemove);
+		return;
+	}
+
+	const int32 SlotIndex = Roster.FindSlotIndex(MemberToRemove);
+	if (SlotIndex != INDEX_NONE && Roster.RemoveMember(MemberToRemove))
+	{
+		if (URsHealthComponent* HealthComponent = MemberToRemove ? MemberToRemove->GetHealthComponent() : nullptr)
+		{
+			HealthComponent->OnHealthChanged.RemoveDynamic(this, &ThisClass::HandleMemberHealthChanged);
+		}
+		if (SwitchCooldownTimers.IsValidIndex(SlotIndex))
+		{
+			GetWorld()->GetTimerManager().ClearTimer(SwitchCooldownTimers[SlotIndex]);
+		}
+		OnPartyRosterChanged.Broadcast();
 	}
 	else
 	{
@@ -49,21 +206,190 @@ void URsPartyComponent::RemovePartyMember(ARsPlayerCharacter* MemberToRemove)
 	}
 }
 
-void URsPartyComponent::SwitchPartyMember(ARsPlayerController* PlayerController, int32 MemberIndex)
+void URsPartyComponent::SwitchPartyMember(ARsPlayerController* PlayerController, int32 SlotIndex)
+{
+	if (!GetOwner()->HasAuthority())
+	{
+		ServerSwitchPartyMember(SlotIndex);
+		return;
+	}
+	
+	const FRsPartySlot* Slot = Roster.FindSlot(SlotIndex);
+	ARsPlayerCharacter* NewPartyMember = Slot ? Slot->Character.Get() : nullptr;
+	if (NewPartyMember == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RsPartyComponent::SwitchPartyMember: Member Not Found"));
+		return;
+	}
+	if (PlayerController->GetPawn() == NewPartyMember)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RsPartyComponent::SwitchPartyMember: Can't switch to same character"));
+		return;
+	}
+	if (!Slot->bAlive || Slot->bOnCooldown)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RsPartyComponent::SwitchPartyMember: Member is dead or on switch cooldown"));
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RsPartySwitch);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Every member owns its ability system, and input bindings and view models are kept, so this only moves the controllers.
+	// Possession routes the ability RPCs of the new member through the player's connection. The new member wakes up in PossessedBy.
+	ARsPlayerCharacter* OldPartyMember = Cast<ARsPlayerCharacter>(PlayerController->GetPawn());
+	if (PlayerController->GetPrevController())
+	{
+		PlayerController->GetPrevController()->Possess(PlayerController->GetPawn());
+	}
+	PlayerController->Possess(NewPartyMember);
+
+	if (FRsPartySlot* OldSlot = Roster.FindSlot(Roster.FindSlotIndex(OldPartyMember)))
+	{
+		if (bDormantInactiveMembers)
+		{
+			SetMemberDormant(*OldSlot, true);
+		}
+		if (SwitchCooldown > 0.f)
+		{
+			OldSlot->bOnCooldown = true;
+			Roster.MarkItemDirty(*OldSlot);
+			
+			SwitchCooldownTimers.SetNum(Roster.GetSlotCount());
+			const FTimerDelegate ClearCooldownDelegate = FTimerDelegate::CreateUObject(this, &ThisClass::ClearSwitchCooldown, OldSlot->SlotIndex);
+			GetWorld()->GetTimerManager().SetTimer(SwitchCooldownTimers[OldSlot->SlotIndex], ClearCooldownDelegate, SwitchCooldown, false);
+		}
+	}
+	RefreshSlotFlags();
+
+	LastSwitchLatencyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	SET_FLOAT_STAT(STAT_RsPartySwitchLatency, LastSwitchLatencyMs);
+	INC_DWORD_STAT(STAT_RsPartySwitches);
+	UE_LOG(LogTemp, Verbose, TEXT("RsPartyComponent::SwitchPartyMember: Switched to %s in %.3f ms"), *GetNameSafe(NewPartyMember), LastSwitchLatencyMs);
+}
+
+void URsPartyComponent::ServerSwitchPartyMember_Implementation(int32 SlotIndex)
 {
-	if (ARsPlayerCharacter* NewPartyMember = GetPartyMember(MemberIndex))
+	if (ARsPlayerController* PlayerController = GetOwner<ARsPlayerController>())
 	{
-		if (PlayerController->GetPawn() != NewPartyMember)
+		SwitchPartyMember(PlayerController, SlotIndex);
+	}
+}
+
+void URsPartyComponent::SetDormantInactiveMembers(bool bEnable)
+{
+	bDormantInactiveMembers = bEnable;
+	for (const FRsPartySlot& Slot : Roster.GetSlots())
+	{
+		if (Slot.Character && !Slot.Character->IsPlayerControlled())
 		{
-			if (PlayerController->GetPrevController())
-			{
-				PlayerController->GetPrevController()->Possess(PlayerController->GetPawn());
-			}
-			PlayerController->Possess(NewPartyMember);
+			Slot.Character->SetDormant(bEnable);
+		}
+	}
+	RefreshSlotFlags();
+}
+
+void URsPartyComponent::SetMemberDormant(FRsPartySlot& Slot, bool bDormant)
+{
+	if (Slot.Character)
+	{
+		Slot.Character->SetDormant(bDormant);
+	}
+}
+
+void URsPartyComponent::ClearSwitchCooldown(int32 SlotIndex)
+{
+	if (FRsPartySlot* Slot = Roster.FindSlot(SlotIndex))
+	{
+		Slot->bOnCooldown = false;
+		Roster.MarkItemDirty(*Slot);
+		OnPartyRosterChanged.Broadcast();
+	}
+}
+
+void URsPartyComponent::RefreshSlotFlags()
+{
+	bool bChanged = false;
+	for (int32 SlotIndex = 0; SlotIndex < Roster.GetSlotCount(); ++SlotIndex)
+	{
+		FRsPartySlot* Slot = Roster.FindSlot(SlotIndex);
+		if (Slot == nullptr || Slot->Character == nullptr)
+		{
+			continue;
 		}
-		else
+
+		URsHealthComponent* HealthComponent = Slot->Character->GetHealthComponent();
+		const bool bAlive = HealthComponent == nullptr || HealthComponent->GetMaxHealth() <= 0.f || HealthComponent->GetCurrentHealth() > 0.f;
+		const bool bDormant = Slot->Character->IsDormant();
+		if (Slot->bAlive != bAlive || Slot->bDormant != bDormant)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("RsPartyComponent::SwitchPartyMember: Can't switch to same character"));
+			Slot->bAlive = bAlive;
+			Slot->bDormant = bDormant;
+			Roster.MarkItemDirty(*Slot);
+			bChanged = true;
 		}
 	}
+
+	if (bChanged)
+	{
+		OnPartyRosterChanged.Broadcast();
+	}
+}
+
+void URsPartyComponent::HandleMemberHealthChanged(float OldValue, float NewValue, AActor* Instigator)
+{
+	// Only death and revival change the roster.
+	if ((OldValue > 0.f) != (NewValue > 0.f) && GetOwner()->HasAuthority())
+	{
+		RefreshSlotFlags();
+	}
+}
+
+void URsPartyComponent::PrewarmSlot(const FRsPartySlot& Slot)
+{
+	if (!IsPrewarmedSwitchEnabled() || Slot.Character == nullptr || GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	OnPrewarmPartyMember.Broadcast(this, Slot.Character);
+}
+
+void URsPartyComponent::HandleSlotReplicated(const FRsPartySlot& Slot)
+{
+	// The character may arrive after its slot.
+	PrewarmSlot(Slot);
 }
+
+void URsPartyComponent::HandleRosterChanged()
+{
+	OnPartyRosterChanged.Broadcast();
+	HandleControlledPawnChanged();
+}
+
+void URsPartyComponent::HandleControlledPawnChanged()
+{
+	const int32 ActiveSlot = GetActiveMemberIndex();
+	if (ActiveSlot != LastActiveSlot)
+	{
+		const int32 OldSlot = LastActiveSlot;
+		LastActiveSlot = ActiveSlot;
+		OnActivePartyMemberChanged.Broadcast(OldSlot, ActiveSlot);
+	}
+}
+
+int32 URsPartyComponent::GetActiveMemberIndex() const
+{
+	if (const AController* OwnerController = GetOwner<AController>())
+	{
+		return Roster.FindSlotIndex(Cast<ARsPlayerCharacter>(OwnerController->GetPawn()));
+	}
+	return INDEX_NONE;
+}
+
+bool URsPartyComponent::IsActiveMember(const ARsPlayerCharacter* Member) const
+{
+	const AController* OwnerController = GetOwner<AController>();
+	return Member && OwnerController && OwnerController->GetPawn() == Member && Roster.FindSlotIndex(Member) != INDEX_NONE;
+}
+
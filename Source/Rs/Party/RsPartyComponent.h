@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "RsPartyRoster.h"
 #include "Components/ActorComponent.h"
 #include "RsPartyComponent.generated.h"
 
@@ -10,6 +11,10 @@
 class ARsPlayerController;
 class ARsPlayerCharacter;
 
+DECLARE_MULTICAST_DELEGATE_TwoParams(FRsPrewarmPartyMember, URsPartyComponent*, ARsPlayerCharacter*);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FRsActivePartyMemberChanged, int32, OldSlotIndex, int32, NewSlotIndex);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FRsPartyRosterChanged);
+
 UCLASS()
 class RS_API URsPartyComponent : public UActorComponent
 {
@@ -18,12 +23,79 @@ class RS_API URsPartyComponent : public UActorComponent
 public:	
 	URsPartyComponent();
 
-	ARsPlayerCharacter* GetPartyMember(int32 MemberIndex) const;
+	// Whether benched members keep their input bindings and view models, so a switch only swaps the active member. (rs.Party.PrewarmedSwitch)
+	static bool IsPrewarmedSwitchEnabled();
+
+	ARsPlayerCharacter* GetPartyMember(int32 SlotIndex) const;
+	const FRsPartySlot* GetPartySlot(int32 SlotIndex) const;
+	int32 FindPartyMemberSlot(const ARsPlayerCharacter* Member) const;
+	int32 GetPartySlotCount() const;
+
+	// Authority only. Clients receive the roster through replication.
 	void AddPartyMember(ARsPlayerCharacter* NewMember);
 	void RemovePartyMember(ARsPlayerCharacter* MemberToRemove);
-	void SwitchPartyMember(ARsPlayerController* PlayerController, int32 MemberIndex);
+
+	// Sends the request to the server when called on a client.
+	void SwitchPartyMember(ARsPlayerController* PlayerController, int32 SlotIndex);
+
+	int32 GetActiveMemberIndex() const;
+	bool IsActiveMember(const ARsPlayerCharacter* Member) const;
+
+	// Puts every member the player doesn't control to sleep, or wakes them all up.
+	void SetDormantInactiveMembers(bool bEnable);
+	bool IsDormantInactiveMembers() const { return bDormantInactiveMembers; }
+
+	// Time spent in the last SwitchPartyMember call, in milliseconds.
+	float GetLastSwitchLatency() const { return LastSwitchLatencyMs; }
+
+	// Called by the owning controller whenever its pawn changes, on server and client.
+	void HandleControlledPawnChanged();
+
+	// Called by the roster on clients.
+	void HandleSlotReplicated(const FRsPartySlot& Slot);
+	void HandleRosterChanged();
+
+	UPROPERTY(BlueprintAssignable)
+	FRsActivePartyMemberChanged OnActivePartyMemberChanged;
+
+	UPROPERTY(BlueprintAssignable)
+	FRsPartyRosterChanged OnPartyRosterChanged;
+
+	// Called when a member joins or replicates while pre-warming is on, so client-only modules (e.g. RsUI view models) can build what a switch needs.
+	static FRsPrewarmPartyMember OnPrewarmPartyMember;
 	
 protected:
-	UPROPERTY(VisibleAnywhere)
-	TArray<ARsPlayerCharacter*> PartyMembers;
+	UFUNCTION(Server, Reliable)
+	void ServerSwitchPartyMember(int32 SlotIndex);
+
+	UPROPERTY(VisibleAnywhere, Replicated)
+	FRsPartyRoster Roster;
+
+	// Members off the field are hidden and stop simulating, so only the controlled member costs CPU.
+	UPROPERTY(EditAnywhere, Category = "RS")
+	bool bDormantInactiveMembers = false;
+
+	// Seconds a switched out member has to wait before it can be switched in again. Zero disables the cooldown.
+	UPROPERTY(EditAnywhere, Category = "RS")
+	float SwitchCooldown = 0.f;
+
+	float LastSwitchLatencyMs = 0.f;
+
+private:
+	void SetMemberDormant(FRsPartySlot& Slot, bool bDormant);
+	void ClearSwitchCooldown(int32 SlotIndex);
+
+	// Authority only. Refreshes the alive and dormant flags, and replicates only the slots that changed.
+	void RefreshSlotFlags();
+
+	UFUNCTION()
+	void HandleMemberHealthChanged(float OldValue, float NewValue, AActor* Instigator);
+
+	void PrewarmSlot(const FRsPartySlot& Slot);
+
+	// Per slot.
+	TArray<FTimerHandle> SwitchCooldownTimers;
+
+	// Slot of the controlled pawn when OnActivePartyMemberChanged was last broadcast.
+	int32 LastActiveSlot = INDEX_NONE;
 };
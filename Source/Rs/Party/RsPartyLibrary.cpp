@@ -4,13 +4,14 @@
 #include "RsPartyLibrary.h"
 
 #include "RsPartyComponent.h"
-#include "Kismet/GameplayStatics.h"
 #include "Rs/Character/RsPlayerCharacter.h"
 #include "Rs/Player/RsPlayerController.h"
 
+FRsResolveOwningPlayer URsPartyLibrary::ResolveOwningPlayer;
+
 void URsPartyLibrary::SwitchPartyMember(UObject* WorldContextObject, int32 NewMemberIndex)
 {
-	if (ARsPlayerController* RsPlayerController = Cast<ARsPlayerController>(UGameplayStatics::GetPlayerController(WorldContextObject, 0)))
+	if (ARsPlayerController* RsPlayerController = FindPartyController(WorldContextObject))
 	{
 		RsPlayerController->GetPartyComponent()->SwitchPartyMember(RsPlayerController, NewMemberIndex);
 	}
@@ -18,7 +19,7 @@ void URsPartyLibrary::SwitchPartyMember(UObject* WorldContextObject, int32 NewMe
 
 void URsPartyLibrary::AddPartyMember(ARsPlayerCharacter* NewMember)
 {
-	if (ARsPlayerController* RsPlayerController = Cast<ARsPlayerController>(UGameplayStatics::GetPlayerController(NewMember, 0)))
+	if (ARsPlayerController* RsPlayerController = FindPartyController(NewMember))
 	{
 		RsPlayerController->GetPartyComponent()->AddPartyMember(NewMember);
 	}
@@ -26,8 +27,60 @@ void URsPartyLibrary::AddPartyMember(ARsPlayerCharacter* NewMember)
 
 void URsPartyLibrary::RemovePartyMember(ARsPlayerCharacter* MemberToRemove)
 {
-	if (ARsPlayerController* RsPlayerController = Cast<ARsPlayerController>(UGameplayStatics::GetPlayerController(MemberToRemove, 0)))
+	if (ARsPlayerController* RsPlayerController = FindPartyController(MemberToRemove))
 	{
 		RsPlayerController->GetPartyComponent()->RemovePartyMember(MemberToRemove);
 	}
 }
+
+ARsPlayerController* URsPartyLibrary::FindPartyController(UObject* ContextObject)
+{
+	// A member already in a party belongs to the controller that owns it.
+	if (const ARsPlayerCharacter* Member = Cast<ARsPlayerCharacter>(ContextObject))
+	{
+		if (const UWorld* World = Member->GetWorld())
+		{
+			for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+			{
+				ARsPlayerController* RsPlayerController = Cast<ARsPlayerController>(It->Get());
+				if (RsPlayerController && RsPlayerController->GetPartyComponent()->FindPartyMemberSlot(Member) != INDEX_NONE)
+				{
+					return RsPlayerController;
+				}
+			}
+		}
+	}
+
+	// Controlled pawns, and actors owned by a player. (player controller, player state, spawned party members)
+	if (const APawn* Pawn = Cast<APawn>(ContextObject))
+	{
+		if (ARsPlayerController* RsPlayerController = Pawn->GetController<ARsPlayerController>())
+		{
+			return RsPlayerController;
+		}
+	}
+	if (AActor* Actor = Cast<AActor>(ContextObject))
+	{
+		for (AActor* Owner = Actor; Owner; Owner = Owner->GetOwner())
+		{
+			if (ARsPlayerController* RsPlayerController = Cast<ARsPlayerController>(Owner))
+			{
+				return RsPlayerController;
+			}
+		}
+	}
+	if (ResolveOwningPlayer.IsBound())
+	{
+		if (ARsPlayerController* RsPlayerController = Cast<ARsPlayerController>(ResolveOwningPlayer.Execute(ContextObject)))
+		{
+			return RsPlayerController;
+		}
+	}
+
+	// Members placed in the level aren't owned by anyone. They join the first local player's party.
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return Cast<ARsPlayerController>(World->GetFirstPlayerController());
+	}
+	return nullptr;
+}
@@ -7,6 +7,12 @@
 #include "RsPartyLibrary.generated.h"
 
 class ARsPlayerCharacter;
+class APlayerController;
+class ARsPlayerController;
+
+// Resolves the player of context objects that aren't actors. (e.g. widgets, bound by the client-only RsUI module)
+DECLARE_DELEGATE_RetVal_OneParam(APlayerController*, FRsResolveOwningPlayer, const UObject*);
+
 /**
  * 
  */
@@ -24,4 +30,9 @@ public:
 	
 	UFUNCTION(BlueprintCallable, Category = "Rs Party Library")
 	static void RemovePartyMember(ARsPlayerCharacter* MemberToRemove);
+
+	// Resolves the player whose party the object belongs to, instead of always using the first player.
+	static ARsPlayerController* FindPartyController(UObject* ContextObject);
+
+	static FRsResolveOwningPlayer ResolveOwningPlayer;
 };
@@ -0,0 +1,131 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsPartyRoster.h"
+
+#include "RsPartyComponent.h"
+#include "Rs/Character/RsPlayerCharacter.h"
+
+void FRsPartySlot::PostReplicatedAdd(const FRsPartyRoster& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->HandleSlotReplicated(*this);
+	}
+}
+
+void FRsPartySlot::PostReplicatedChange(const FRsPartyRoster& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->HandleSlotReplicated(*this);
+	}
+}
+
+const FRsPartySlot* FRsPartyRoster::FindSlot(int32 SlotIndex) const
+{
+	if (SlotToItem.IsValidIndex(SlotIndex) && SlotToItem[SlotIndex] != INDEX_NONE)
+	{
+		return &Slots[SlotToItem[SlotIndex]];
+	}
+	return nullptr;
+}
+
+FRsPartySlot* FRsPartyRoster::FindSlot(int32 SlotIndex)
+{
+	return const_cast<FRsPartySlot*>(static_cast<const FRsPartyRoster*>(this)->FindSlot(SlotIndex));
+}
+
+int32 FRsPartyRoster::FindSlotIndex(const ARsPlayerCharacter* Character) const
+{
+	if (const int32* SlotIndex = CharacterToSlot.Find(Character))
+	{
+		return *SlotIndex;
+	}
+	return INDEX_NONE;
+}
+
+FRsPartySlot* FRsPartyRoster::AddMember(ARsPlayerCharacter* Character)
+{
+	if (Character == nullptr || CharacterToSlot.Contains(Character))
+	{
+		return nullptr;
+	}
+
+	int32 SlotIndex = SlotToItem.Find(INDEX_NONE);
+	if (SlotIndex == INDEX_NONE)
+	{
+		SlotIndex = SlotToItem.Add(INDEX_NONE);
+	}
+
+	const int32 ItemIndex = Slots.AddDefaulted();
+	FRsPartySlot& NewSlot = Slots[ItemIndex];
+	NewSlot.Character = Character;
+	NewSlot.SlotIndex = SlotIndex;
+	MarkItemDirty(NewSlot);
+
+	SlotToItem[SlotIndex] = ItemIndex;
+	CharacterToSlot.Add(Character, SlotIndex);
+	return &NewSlot;
+}
+
+bool FRsPartyRoster::RemoveMember(const ARsPlayerCharacter* Character)
+{
+	int32 SlotIndex;
+	if (!CharacterToSlot.RemoveAndCopyValue(Character, SlotIndex))
+	{
+		return false;
+	}
+
+	const int32 ItemIndex = SlotToItem[SlotIndex];
+	SlotToItem[SlotIndex] = INDEX_NONE;
+	Slots.RemoveAtSwap(ItemIndex);
+	if (Slots.IsValidIndex(ItemIndex))
+	{
+		SlotToItem[Slots[ItemIndex].SlotIndex] = ItemIndex;
+	}
+
+	// Trim trailing free slots.
+	while (SlotToItem.Num() > 0 && SlotToItem.Last() == INDEX_NONE)
+	{
+		SlotToItem.Pop();
+	}
+	
+	MarkArrayDirty();
+	return true;
+}
+
+void FRsPartyRoster::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	// Item order isn't kept across the network, so indices are rebuilt from the received slots.
+	RebuildIndex();
+	
+	if (Owner)
+	{
+		Owner->HandleRosterChanged();
+	}
+}
+
+void FRsPartyRoster::RebuildIndex()
+{
+	SlotToItem.Reset();
+	CharacterToSlot.Reset();
+	for (int32 ItemIndex = 0; ItemIndex < Slots.Num(); ++ItemIndex)
+	{
+		const FRsPartySlot& Slot = Slots[ItemIndex];
+		if (Slot.SlotIndex < 0)
+		{
+			continue;
+		}
+		
+		while (SlotToItem.Num() <= Slot.SlotIndex)
+		{
+			SlotToItem.Add(INDEX_NONE);
+		}
+		SlotToItem[Slot.SlotIndex] = ItemIndex;
+		if (Slot.Character)
+		{
+			CharacterToSlot.Add(Slot.Character, Slot.SlotIndex);
+		}
+	}
+}
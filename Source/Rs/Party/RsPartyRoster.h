@@ -0,0 +1,90 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "RsPartyRoster.generated.h"
+
+class ARsPlayerCharacter;
+class URsPartyComponent;
+struct FRsPartyRoster;
+
+/**
+ * One party member. The slot index stays the same while the member is in the party.
+ */
+USTRUCT(BlueprintType)
+struct RS_API FRsPartySlot : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "RS")
+	TObjectPtr<ARsPlayerCharacter> Character;
+
+	UPROPERTY(BlueprintReadOnly, Category = "RS")
+	int32 SlotIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "RS")
+	bool bAlive = true;
+
+	// Switched out recently. Can't be switched in until the party's switch cooldown ends.
+	UPROPERTY(BlueprintReadOnly, Category = "RS")
+	bool bOnCooldown = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "RS")
+	bool bDormant = false;
+
+	void PostReplicatedAdd(const FRsPartyRoster& InArraySerializer);
+	void PostReplicatedChange(const FRsPartyRoster& InArraySerializer);
+};
+
+/**
+ * Replicated party members. Clients only receive the slots that changed.
+ */
+USTRUCT()
+struct RS_API FRsPartyRoster : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	const FRsPartySlot* FindSlot(int32 SlotIndex) const;
+	FRsPartySlot* FindSlot(int32 SlotIndex);
+	int32 FindSlotIndex(const ARsPlayerCharacter* Character) const;
+
+	// Highest slot index + 1. Slots below it may be free.
+	int32 GetSlotCount() const { return SlotToItem.Num(); }
+	const TArray<FRsPartySlot>& GetSlots() const { return Slots; }
+
+	// Authority only. Takes the lowest free slot.
+	FRsPartySlot* AddMember(ARsPlayerCharacter* Character);
+	bool RemoveMember(const ARsPlayerCharacter* Character);
+
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FRsPartySlot, FRsPartyRoster>(Slots, DeltaParms, *this);
+	}
+
+	UPROPERTY(NotReplicated)
+	TObjectPtr<URsPartyComponent> Owner;
+
+private:
+	void RebuildIndex();
+
+	UPROPERTY()
+	TArray<FRsPartySlot> Slots;
+
+	// Slot index -> index in Slots. INDEX_NONE for free slots.
+	TArray<int32> SlotToItem;
+
+	TMap<TObjectKey<ARsPlayerCharacter>, int32> CharacterToSlot;
+};
+
+template<>
+struct TStructOpsTypeTraits<FRsPartyRoster> : public TStructOpsTypeTraitsBase2<FRsPartyRoster>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -21,6 +21,17 @@ void ARsPlayerController::OnPossess(APawn* InPawn)
 	Super::OnPossess(InPawn);
 }
 
+void ARsPlayerController::SetPawn(APawn* InPawn)
+{
+	Super::SetPawn(InPawn);
+
+	// Runs on the server when possessing, and on the owning client when the pawn replicates.
+	if (PartyComponent)
+	{
+		PartyComponent->HandleControlledPawnChanged();
+	}
+}
+
 TObjectPtr<AController> ARsPlayerController::GetPrevController() const
 {
 	return PrevController;
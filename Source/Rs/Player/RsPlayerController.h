@@ -24,6 +24,7 @@ class RS_API ARsPlayerController : public ACommonPlayerController
 public:
 	ARsPlayerController();
 	virtual void OnPossess(APawn* InPawn) override;
+	virtual void SetPawn(APawn* InPawn) override;
 
 	TObjectPtr<AController> GetPrevController() const;
 	URsPartyComponent* GetPartyComponent() const;
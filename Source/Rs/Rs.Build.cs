@@ -15,19 +15,20 @@ public class Rs : ModuleRules
 			"Engine", 
 			"InputCore", 
 			"EnhancedInput",
+			"NetCore",
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[]
 		{
-			"UMG",
+			"AIModule",
+			"NavigationSystem",
 			"GameplayAbilities", 
 			"GameplayTasks", 
 			"GameplayTags", 
-			"ModelViewViewModel",
-			"CommonUI",
 			"CommonGame",
 			"ModularGameplayActors",
 			"TargetingSystem",
+			"Json",
 		});
 	}
 }
@@ -0,0 +1,536 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsCombatBenchmarkSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "Dom/JsonObject.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformProcess.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectArray.h"
+#include "Rs/AbilitySystem/Attributes/RsHealthSet.h"
+#include "Rs/AbilitySystem/Component/RsAbilitySystemComponent.h"
+#include "Rs/AI/Subsystem/RsCrowdSubsystem.h"
+#include "Rs/Character/RsEnemyCharacter.h"
+#include "Rs/Character/RsPlayerCharacter.h"
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRsBenchmarkCombat(
+	TEXT("rs.Benchmark.Combat"),
+	TEXT("rs.Benchmark.Combat [NumEnemies] [Duration]. Starts the combat benchmark, or stops it and writes the report if it is running."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		URsCombatBenchmarkSubsystem* BenchmarkSubsystem = World ? World->GetSubsystem<URsCombatBenchmarkSubsystem>() : nullptr;
+		if (BenchmarkSubsystem == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("rs.Benchmark.Combat: Needs a game world"));
+			return;
+		}
+
+		if (BenchmarkSubsystem->IsRunning())
+		{
+			BenchmarkSubsystem->StopBenchmark();
+			return;
+		}
+
+		const int32 NumEnemies = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : INDEX_NONE;
+		const float Duration = Args.IsValidIndex(1) ? FCString::Atof(*Args[1]) : -1.f;
+		BenchmarkSubsystem->StartBenchmark(NumEnemies, Duration, false);
+	}));
+
+namespace RsCombatBenchmark
+{
+	struct FTimingSummary
+	{
+		float Average = 0.f;
+		float P50 = 0.f;
+		float P90 = 0.f;
+		float P99 = 0.f;
+		float Max = 0.f;
+	};
+
+	static FTimingSummary Summarize(TArray<float> Samples)
+	{
+		FTimingSummary Summary;
+		if (Samples.IsEmpty())
+		{
+			return Summary;
+		}
+
+		Samples.Sort();
+		auto Percentile = [&Samples](float Fraction)
+		{
+			return Samples[FMath::Clamp(FMath::CeilToInt(Fraction * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+		};
+
+		float Sum = 0.f;
+		for (const float Sample : Samples)
+		{
+			Sum += Sample;
+		}
+		Summary.Average = Sum / Samples.Num();
+		Summary.P50 = Percentile(0.5f);
+		Summary.P90 = Percentile(0.9f);
+		Summary.P99 = Percentile(0.99f);
+		Summary.Max = Samples.Last();
+		return Summary;
+	}
+
+	static TSharedRef<FJsonObject> ToJson(const FTimingSummary& Summary)
+	{
+		TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		JsonObject->SetNumberField(TEXT("avg"), Summary.Average);
+		JsonObject->SetNumberField(TEXT("p50"), Summary.P50);
+		JsonObject->SetNumberField(TEXT("p90"), Summary.P90);
+		JsonObject->SetNumberField(TEXT("p99"), Summary.P99);
+		JsonObject->SetNumberField(TEXT("max"), Summary.Max);
+		return JsonObject;
+	}
+
+	static double ToMB(uint64 Bytes)
+	{
+		return Bytes / (1024.0 * 1024.0);
+	}
+}
+
+URsCombatBenchmarkSubsystem* URsCombatBenchmarkSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsCombatBenchmarkSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsCombatBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsCombatBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("RsCombatBenchmark")))
+	{
+		int32 CommandLineEnemies = INDEX_NONE;
+		float CommandLineDuration = -1.f;
+		FParse::Value(FCommandLine::Get(), TEXT("RsBenchmarkEnemies="), CommandLineEnemies);
+		FParse::Value(FCommandLine::Get(), TEXT("RsBenchmarkDuration="), CommandLineDuration);
+		StartBenchmark(CommandLineEnemies, CommandLineDuration, true);
+	}
+}
+
+void URsCombatBenchmarkSubsystem::Deinitialize()
+{
+	StopBenchmark();
+	Super::Deinitialize();
+}
+
+void URsCombatBenchmarkSubsystem::StartBenchmark(int32 InNumEnemies, float InDuration, bool bInExitWhenDone)
+{
+	// Unattended runs have nobody to notice a benchmark that never starts, so they fail and exit instead of idling forever.
+	auto FailStart = [bInExitWhenDone](const TCHAR* Reason)
+	{
+		if (bInExitWhenDone)
+		{
+			UE_LOG(LogTemp, Error, TEXT("RsCombatBenchmarkSubsystem::StartBenchmark: %s. Exiting"), Reason);
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RsCombatBenchmarkSubsystem::StartBenchmark: %s"), Reason);
+		}
+	};
+
+	if (bRunning || GetWorld()->GetNetMode() == NM_Client)
+	{
+		FailStart(TEXT("Already running, or no authority"));
+		return;
+	}
+
+	LoadedEnemyClasses.Reset();
+	for (const TSoftClassPtr<ARsEnemyCharacter>& EnemyClass : EnemyClasses)
+	{
+		if (const TSubclassOf<ARsEnemyCharacter> LoadedClass = EnemyClass.LoadSynchronous())
+		{
+			LoadedEnemyClasses.Add(LoadedClass);
+		}
+	}
+	if (LoadedEnemyClasses.IsEmpty())
+	{
+		FailStart(TEXT("No enemy class could be loaded, check EnemyClasses in DefaultGame.ini"));
+		return;
+	}
+
+	TargetNumEnemies = InNumEnemies >= 0 ? InNumEnemies : NumEnemies;
+	TargetDuration = InDuration > 0.f ? InDuration : Duration;
+	bExitWhenDone = bInExitWhenDone;
+	bRunning = true;
+	bRecording = false;
+	SimulatedTime = 0.f;
+	RotationAccumulator = 0.f;
+	RotationStep = 0;
+	NextEnemyClassIndex = 0;
+	RandomStream.Initialize(0);
+	LastFrameTime = FPlatformTime::Seconds();
+
+	// Enemies gather around the party, which is where the abilities are cast.
+	Center = FVector::ZeroVector;
+	bool bFoundCenter = false;
+	for (TActorIterator<ARsPlayerCharacter> It(GetWorld()); It; ++It)
+	{
+		if (!bFoundCenter)
+		{
+			Center = It->GetActorLocation();
+			bFoundCenter = true;
+		}
+		BindCharacter(*It);
+	}
+	if (URsCrowdSubsystem* CrowdSubsystem = URsCrowdSubsystem::Get(this))
+	{
+		CrowdSubsystem->OnCrowdEntityKilled.AddUObject(this, &ThisClass::HandleCrowdEntityKilled);
+	}
+	if (!bFoundCenter)
+	{
+		SpawnBots();
+		if (Bots.Num() > 0)
+		{
+			Center = Bots[0]->GetActorLocation();
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RsCombatBenchmarkSubsystem::StartBenchmark: No player character and no bot could be spawned, check BotCharacterClass in DefaultGame.ini. No ability rotation will run"));
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("RsCombatBenchmarkSubsystem::StartBenchmark: %d enemies, %.0f s after %.0f s of warm-up"), TargetNumEnemies, TargetDuration, WarmupDuration);
+}
+
+void URsCombatBenchmarkSubsystem::StopBenchmark()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+	UnbindAll();
+
+	if (bRecording)
+	{
+		WriteReport();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RsCombatBenchmarkSubsystem::StopBenchmark: Stopped during warm-up, no report written"));
+	}
+	bRecording = false;
+
+	FrameTimesMs.Empty();
+	GameThreadTimesMs.Empty();
+	Enemies.Reset();
+
+	for (const TWeakObjectPtr<ARsPlayerCharacter>& Bot : Bots)
+	{
+		if (Bot.IsValid())
+		{
+			if (AController* Controller = Bot->GetController())
+			{
+				Controller->Destroy();
+			}
+			Bot->Destroy();
+		}
+	}
+	Bots.Reset();
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void URsCombatBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = FPlatformTime::Seconds();
+	if (bRecording)
+	{
+		FrameTimesMs.Add((Now - LastFrameTime) * 1000.0);
+		GameThreadTimesMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	}
+	LastFrameTime = Now;
+
+	SimulatedTime += DeltaTime;
+	if (!bRecording && SimulatedTime >= WarmupDuration)
+	{
+		bRecording = true;
+		RecordStartTime = Now;
+		DamageEvents = 0;
+		Kills = 0;
+		AbilityActivations = 0;
+		EnemiesSpawned = 0;
+		FrameTimesMs.Reset(FMath::CeilToInt(TargetDuration * 60.f));
+		GameThreadTimesMs.Reset(FMath::CeilToInt(TargetDuration * 60.f));
+		StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+		PeakUsedPhysical = StartUsedPhysical;
+		StartObjectCount = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	}
+
+	MaintainEnemies();
+
+	RotationAccumulator += DeltaTime;
+	if (RotationAccumulator >= RotationInterval)
+	{
+		RotationAccumulator -= RotationInterval;
+		RunAbilityRotation();
+
+		// Reading memory stats isn't free, so sample once per rotation step instead of every frame.
+		if (bRecording)
+		{
+			PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+		}
+	}
+
+	if (bRecording && SimulatedTime - WarmupDuration >= TargetDuration)
+	{
+		StopBenchmark();
+	}
+}
+
+bool URsCombatBenchmarkSubsystem::IsTickable() const
+{
+	return bRunning;
+}
+
+TStatId URsCombatBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsCombatBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void URsCombatBenchmarkSubsystem::SpawnBots()
+{
+	const TSubclassOf<ARsPlayerCharacter> BotClass = BotCharacterClass.LoadSynchronous();
+	if (BotClass == nullptr)
+	{
+		return;
+	}
+
+	FTransform SpawnTransform = FTransform::Identity;
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		SpawnTransform = It->GetActorTransform();
+		break;
+	}
+
+	for (int32 Index = 0; Index < NumBots; ++Index)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		ARsPlayerCharacter* Bot = GetWorld()->SpawnActor<ARsPlayerCharacter>(BotClass, SpawnTransform, SpawnParams);
+		if (Bot == nullptr)
+		{
+			continue;
+		}
+
+		// Possessed by its AIControllerClass, so the ability actor info has a controller like a player's character does.
+		if (Bot->GetController() == nullptr)
+		{
+			Bot->SpawnDefaultController();
+		}
+		Bots.Add(Bot);
+		BindCharacter(Bot);
+	}
+}
+
+void URsCombatBenchmarkSubsystem::MaintainEnemies()
+{
+	// Dead enemies are left to their death ability and replaced right away.
+	Enemies.RemoveAllSwap([](const TWeakObjectPtr<ARsEnemyCharacter>& Enemy)
+	{
+		const UAbilitySystemComponent* AbilitySystemComponent = Enemy.IsValid() ? Enemy->GetAbilitySystemComponent() : nullptr;
+		return AbilitySystemComponent == nullptr || AbilitySystemComponent->GetNumericAttribute(URsHealthSet::GetCurrentHealthAttribute()) <= 0.f;
+	});
+
+	for (int32 NumSpawned = 0; Enemies.Num() < TargetNumEnemies && NumSpawned < MaxSpawnsPerFrame; ++NumSpawned)
+	{
+		const TSubclassOf<ARsEnemyCharacter> EnemyClass = LoadedEnemyClasses[NextEnemyClassIndex++ % LoadedEnemyClasses.Num()];
+		const float Angle = RandomStream.FRandRange(0.f, UE_TWO_PI);
+		const float Distance = SpawnRadius * FMath::Sqrt(RandomStream.FRand());
+		const FVector Location = Center + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.f);
+		const FRotator Rotation(0.f, RandomStream.FRandRange(-180.f, 180.f), 0.f);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		ARsEnemyCharacter* Enemy = GetWorld()->SpawnActor<ARsEnemyCharacter>(EnemyClass, Location, Rotation, SpawnParams);
+		if (Enemy == nullptr)
+		{
+			break;
+		}
+
+		if (Enemy->GetController() == nullptr)
+		{
+			Enemy->SpawnDefaultController();
+		}
+		Enemies.Add(Enemy);
+		BindCharacter(Enemy);
+		++EnemiesSpawned;
+	}
+}
+
+void URsCombatBenchmarkSubsystem::RunAbilityRotation()
+{
+	if (AbilityRotation.IsEmpty())
+	{
+		return;
+	}
+
+	const FGameplayTag AbilityTag = AbilityRotation[RotationStep++ % AbilityRotation.Num()];
+	for (TActorIterator<ARsPlayerCharacter> It(GetWorld()); It; ++It)
+	{
+		if (URsAbilitySystemComponent* AbilitySystemComponent = It->GetRsAbilitySystemComponent())
+		{
+			const FGameplayAbilitySpecHandle AbilityHandle = AbilitySystemComponent->FindAbilitySpecHandleWithTag(AbilityTag, false);
+			if (AbilityHandle.IsValid())
+			{
+				AbilitySystemComponent->TryActivateAbility(AbilityHandle);
+			}
+		}
+	}
+}
+
+void URsCombatBenchmarkSubsystem::BindCharacter(ARsCharacterBase* Character)
+{
+	UAbilitySystemComponent* AbilitySystemComponent = Character ? Character->GetAbilitySystemComponent() : nullptr;
+	if (AbilitySystemComponent == nullptr || BoundAbilitySystems.Contains(AbilitySystemComponent))
+	{
+		return;
+	}
+
+	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(URsHealthSet::GetCurrentHealthAttribute()).AddUObject(this, &ThisClass::HandleHealthChanged);
+	AbilitySystemComponent->AbilityActivatedCallbacks.AddUObject(this, &ThisClass::HandleAbilityActivated);
+	BoundAbilitySystems.Add(AbilitySystemComponent);
+}
+
+void URsCombatBenchmarkSubsystem::UnbindAll()
+{
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakAbilitySystem : BoundAbilitySystems)
+	{
+		if (UAbilitySystemComponent* AbilitySystemComponent = WeakAbilitySystem.Get())
+		{
+			AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(URsHealthSet::GetCurrentHealthAttribute()).RemoveAll(this);
+			AbilitySystemComponent->AbilityActivatedCallbacks.RemoveAll(this);
+		}
+	}
+	BoundAbilitySystems.Reset();
+
+	if (URsCrowdSubsystem* CrowdSubsystem = URsCrowdSubsystem::Get(this))
+	{
+		CrowdSubsystem->OnCrowdEntityKilled.RemoveAll(this);
+	}
+}
+
+void URsCombatBenchmarkSubsystem::HandleHealthChanged(const FOnAttributeChangeData& ChangeData)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	if (ChangeData.NewValue < ChangeData.OldValue)
+	{
+		++DamageEvents;
+	}
+	if (ChangeData.OldValue > 0.f && ChangeData.NewValue <= 0.f)
+	{
+		++Kills;
+	}
+}
+
+void URsCombatBenchmarkSubsystem::HandleAbilityActivated(UGameplayAbility* Ability)
+{
+	if (bRecording)
+	{
+		++AbilityActivations;
+	}
+}
+
+void URsCombatBenchmarkSubsystem::HandleCrowdEntityKilled(TSubclassOf<ARsEnemyCharacter> EnemyClass, const FVector& Location, FGenericTeamId TeamID)
+{
+	if (bRecording)
+	{
+		++Kills;
+	}
+}
+
+void URsCombatBenchmarkSubsystem::WriteReport() const
+{
+	using namespace RsCombatBenchmark;
+
+	const float RecordedTime = FMath::Max(SimulatedTime - WarmupDuration, UE_KINDA_SMALL_NUMBER);
+	const FTimingSummary FrameTime = Summarize(FrameTimesMs);
+	const FTimingSummary GameThreadTime = Summarize(GameThreadTimesMs);
+	const uint64 EndUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	const int32 ObjectCountDelta = GUObjectArray.GetObjectArrayNumMinusAvailable() - StartObjectCount;
+	const FString MapName = GetWorld()->GetMapName();
+	const FString Timestamp = FDateTime::Now().ToString();
+	const int64 ExecutableSize = IFileManager::Get().FileSize(FPlatformProcess::ExecutablePath());
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("map"), MapName);
+	Report->SetStringField(TEXT("timestamp"), Timestamp);
+	Report->SetStringField(TEXT("build_configuration"), LexToString(FApp::GetBuildConfiguration()));
+	Report->SetBoolField(TEXT("dedicated_server"), IsRunningDedicatedServer());
+	Report->SetNumberField(TEXT("executable_size_mb"), ToMB(FMath::Max<int64>(ExecutableSize, 0)));
+	Report->SetNumberField(TEXT("bots"), Bots.Num());
+	Report->SetNumberField(TEXT("enemies"), TargetNumEnemies);
+	Report->SetNumberField(TEXT("simulated_seconds"), RecordedTime);
+	Report->SetNumberField(TEXT("wall_seconds"), FPlatformTime::Seconds() - RecordStartTime);
+	Report->SetNumberField(TEXT("frames"), FrameTimesMs.Num());
+	Report->SetObjectField(TEXT("frame_ms"), ToJson(FrameTime));
+	Report->SetObjectField(TEXT("game_thread_ms"), ToJson(GameThreadTime));
+	Report->SetNumberField(TEXT("damage_events"), DamageEvents);
+	Report->SetNumberField(TEXT("damage_events_per_second"), DamageEvents / RecordedTime);
+	Report->SetNumberField(TEXT("kills"), Kills);
+	Report->SetNumberField(TEXT("ability_activations"), AbilityActivations);
+	Report->SetNumberField(TEXT("ability_activations_per_second"), AbilityActivations / RecordedTime);
+	Report->SetNumberField(TEXT("enemies_spawned"), EnemiesSpawned);
+	Report->SetNumberField(TEXT("used_physical_start_mb"), ToMB(StartUsedPhysical));
+	Report->SetNumberField(TEXT("used_physical_end_mb"), ToMB(EndUsedPhysical));
+	Report->SetNumberField(TEXT("used_physical_peak_mb"), ToMB(FMath::Max(PeakUsedPhysical, EndUsedPhysical)));
+	Report->SetNumberField(TEXT("uobject_count_delta"), ObjectCountDelta);
+
+	const FString ReportDir = FPaths::ProfilingDir() / TEXT("RsCombatBenchmark");
+	const FString JsonPath = ReportDir / FString::Printf(TEXT("RsCombatBenchmark_%s_%s.json"), *MapName, *Timestamp);
+
+	FString JsonString;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
+	FJsonSerializer::Serialize(Report, JsonWriter);
+	FFileHelper::SaveStringToFile(JsonString, *JsonPath);
+
+	// One row per run in a single file, so runs can be compared over time.
+	const FString CsvPath = ReportDir / TEXT("RsCombatBenchmark.csv");
+	FString CsvString;
+	if (!IFileManager::Get().FileExists(*CsvPath))
+	{
+		CsvString += TEXT("Timestamp,Map,BuildConfiguration,DedicatedServer,ExecutableSizeMB,Bots,Enemies,SimulatedSeconds,Frames,FrameMsAvg,FrameMsP50,FrameMsP90,FrameMsP99,FrameMsMax,")
+			TEXT("GameThreadMsAvg,GameThreadMsP50,GameThreadMsP90,GameThreadMsP99,GameThreadMsMax,DamageEventsPerSecond,Kills,AbilityActivationsPerSecond,")
+			TEXT("EnemiesSpawned,UsedPhysicalStartMB,UsedPhysicalEndMB,UsedPhysicalPeakMB,UObjectCountDelta\n");
+	}
+	CsvString += FString::Printf(TEXT("%s,%s,%s,%d,%.1f,%d,%d,%.1f,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%lld,%.2f,%lld,%.1f,%.1f,%.1f,%d\n"),
+		*Timestamp, *MapName, LexToString(FApp::GetBuildConfiguration()), IsRunningDedicatedServer() ? 1 : 0, ToMB(FMath::Max<int64>(ExecutableSize, 0)), Bots.Num(), TargetNumEnemies, RecordedTime, FrameTimesMs.Num(),
+		FrameTime.Average, FrameTime.P50, FrameTime.P90, FrameTime.P99, FrameTime.Max,
+		GameThreadTime.Average, GameThreadTime.P50, GameThreadTime.P90, GameThreadTime.P99, GameThreadTime.Max,
+		DamageEvents / RecordedTime, Kills, AbilityActivations / RecordedTime,
+		EnemiesSpawned, ToMB(StartUsedPhysical), ToMB(EndUsedPhysical), ToMB(FMath::Max(PeakUsedPhysical, EndUsedPhysical)), ObjectCountDelta);
+	FFileHelper::SaveStringToFile(CsvString, *CsvPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+
+	UE_LOG(LogTemp, Log, TEXT("RsCombatBenchmarkSubsystem::WriteReport: %d frames, frame p50 %.2f ms, p99 %.2f ms, %.1f damage events/s, %.1f activations/s. Written to %s"),
+		FrameTimesMs.Num(), FrameTime.P50, FrameTime.P99, DamageEvents / RecordedTime, AbilityActivations / RecordedTime, *JsonPath);
+}
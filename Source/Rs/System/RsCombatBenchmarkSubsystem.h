@@ -0,0 +1,131 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "GenericTeamAgentInterface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsCombatBenchmarkSubsystem.generated.h"
+
+class ARsCharacterBase;
+class ARsEnemyCharacter;
+class ARsPlayerCharacter;
+class UAbilitySystemComponent;
+class UGameplayAbility;
+struct FOnAttributeChangeData;
+
+/**
+ * Reproducible combat load for performance regression tracking.
+ * Keeps a fixed number of enemies alive around the party, makes every player character go through a scripted ability rotation,
+ * and after a fixed simulated duration writes frame time percentiles, damage events per second, ability activations and memory growth
+ * to Saved/Profiling/RsCombatBenchmark. Each run writes a JSON report and appends one row to RsCombatBenchmark.csv.
+ * Starts on map load with -RsCombatBenchmark and exits when done, e.g.
+ * "Rs LV_BattleArena -game -nullrhi -unattended -benchmark -fps=30 -RsCombatBenchmark -RsBenchmarkEnemies=40 -RsBenchmarkDuration=120".
+ * -benchmark -fps=30 gives a fixed time step, so every run simulates the same number of frames.
+ * A headless dedicated server has no player, so NumBots of BotCharacterClass are spawned and possessed by AI to run the rotation.
+ */
+UCLASS(Config = Game)
+class RS_API URsCombatBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsCombatBenchmarkSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	void StartBenchmark(int32 InNumEnemies, float InDuration, bool bInExitWhenDone);
+
+	// Writes the report of what has run so far.
+	void StopBenchmark();
+
+	bool IsRunning() const { return bRunning; }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void SpawnBots();
+	void MaintainEnemies();
+	void RunAbilityRotation();
+	void BindCharacter(ARsCharacterBase* Character);
+	void UnbindAll();
+	void HandleHealthChanged(const FOnAttributeChangeData& ChangeData);
+	void HandleAbilityActivated(UGameplayAbility* Ability);
+	void HandleCrowdEntityKilled(TSubclassOf<ARsEnemyCharacter> EnemyClass, const FVector& Location, FGenericTeamId TeamID);
+	void WriteReport() const;
+
+	// Spawned in turns. (e.g. BP_EnemyCharacter with ABS_EnemyCharacter, BP_SandbagCharacter with ABS_SandbagCharacter)
+	UPROPERTY(Config)
+	TArray<TSoftClassPtr<ARsEnemyCharacter>> EnemyClasses;
+
+	UPROPERTY(Config)
+	int32 NumEnemies = 30;
+
+	// Simulated seconds, not including the warm-up.
+	UPROPERTY(Config)
+	float Duration = 120.f;
+
+	// Frames in the first seconds are not recorded, to leave out spawning and first-use hitches.
+	UPROPERTY(Config)
+	float WarmupDuration = 3.f;
+
+	// Enemies are kept in a disc of this radius around the party.
+	UPROPERTY(Config)
+	float SpawnRadius = 1200.f;
+
+	UPROPERTY(Config)
+	int32 MaxSpawnsPerFrame = 4;
+
+	// Ability tags cast in order by every player character, one step per RotationInterval. (e.g. combo, ranged, skill, ultimate)
+	UPROPERTY(Config)
+	TArray<FGameplayTag> AbilityRotation;
+
+	UPROPERTY(Config)
+	float RotationInterval = 1.5f;
+
+	// Spawned at a player start when there is no player character, e.g. on a dedicated server with no clients.
+	UPROPERTY(Config)
+	TSoftClassPtr<ARsPlayerCharacter> BotCharacterClass;
+
+	UPROPERTY(Config)
+	int32 NumBots = 1;
+
+	UPROPERTY(Transient)
+	TArray<TSubclassOf<ARsEnemyCharacter>> LoadedEnemyClasses;
+
+	TArray<TWeakObjectPtr<ARsEnemyCharacter>> Enemies;
+	TArray<TWeakObjectPtr<ARsPlayerCharacter>> Bots;
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> BoundAbilitySystems;
+
+	// Fixed seed, so every run spawns enemies at the same places.
+	FRandomStream RandomStream;
+
+	FVector Center = FVector::ZeroVector;
+	int32 TargetNumEnemies = 0;
+	float TargetDuration = 0.f;
+	float SimulatedTime = 0.f;
+	float RotationAccumulator = 0.f;
+	int32 RotationStep = 0;
+	int32 NextEnemyClassIndex = 0;
+	double LastFrameTime = 0.0;
+	double RecordStartTime = 0.0;
+	bool bRunning = false;
+	bool bRecording = false;
+	bool bExitWhenDone = false;
+
+	TArray<float> FrameTimesMs;
+	TArray<float> GameThreadTimesMs;
+	int64 DamageEvents = 0;
+	int64 Kills = 0;
+	int64 AbilityActivations = 0;
+	int64 EnemiesSpawned = 0;
+	uint64 StartUsedPhysical = 0;
+	uint64 PeakUsedPhysical = 0;
+	int32 StartObjectCount = 0;
+};
@@ -0,0 +1,265 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsSignificanceSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "Algo/SortBy.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Rs/AbilitySystem/Attributes/RsHealthSet.h"
+#include "Rs/Character/RsCharacterBase.h"
+
+static FAutoConsoleCommandWithWorld CmdRsSignificanceDump(
+	TEXT("rs.Significance.Dump"),
+	TEXT("Logs the significance score and tier of every registered character, and the number of characters per tier."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const URsSignificanceSubsystem* SignificanceSubsystem = World ? World->GetSubsystem<URsSignificanceSubsystem>() : nullptr)
+		{
+			SignificanceSubsystem->DumpToLog();
+		}
+	}));
+
+URsSignificanceSubsystem* URsSignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsSignificanceSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsSignificanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && !IsRunningDedicatedServer();
+}
+
+bool URsSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsSignificanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (Tiers.IsEmpty())
+	{
+		// Full, reduced, and background.
+		auto AddTier = [this](float MinScore, bool bEnableUpdateRateOptimizations, float AnimationTickInterval, bool bSuppressGameplayCues, float ViewModelUpdateInterval, int32 AILODTier)
+		{
+			FRsSignificanceTier& Tier = Tiers.AddDefaulted_GetRef();
+			Tier.MinScore = MinScore;
+			Tier.bEnableUpdateRateOptimizations = bEnableUpdateRateOptimizations;
+			Tier.AnimationTickInterval = AnimationTickInterval;
+			Tier.bSuppressGameplayCues = bSuppressGameplayCues;
+			Tier.ViewModelUpdateInterval = ViewModelUpdateInterval;
+			Tier.AILODTier = AILODTier;
+		};
+		AddTier(0.6f, false, 0.f, false, 0.f, 0);
+		AddTier(0.25f, true, 0.f, false, 0.1f, 1);
+		AddTier(0.f, true, 0.1f, true, 0.5f, 2);
+	}
+}
+
+void URsSignificanceSubsystem::RegisterCharacter(ARsCharacterBase* Character)
+{
+	if (Character == nullptr || EntryIndices.Contains(Character))
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Character = Character;
+	Entry.CharacterKey = Character;
+	// Player characters get their ability system later, but are always fully significant anyway.
+	if (UAbilitySystemComponent* AbilitySystemComponent = Character->GetAbilitySystemComponent())
+	{
+		Entry.HealthChangedDelegateHandle = AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(URsHealthSet::GetCurrentHealthAttribute()).AddUObject(this, &ThisClass::HandleHealthChanged, TWeakObjectPtr<ARsCharacterBase>(Character));
+	}
+	EntryIndices.Add(Character, Entries.Num() - 1);
+}
+
+void URsSignificanceSubsystem::UnregisterCharacter(ARsCharacterBase* Character)
+{
+	int32 Index;
+	if (!EntryIndices.RemoveAndCopyValue(Character, Index))
+	{
+		return;
+	}
+
+	if (UAbilitySystemComponent* AbilitySystemComponent = Character->GetAbilitySystemComponent())
+	{
+		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(URsHealthSet::GetCurrentHealthAttribute()).Remove(Entries[Index].HealthChangedDelegateHandle);
+	}
+	
+	Entries.RemoveAtSwap(Index);
+	if (Entries.IsValidIndex(Index))
+	{
+		EntryIndices.Add(Entries[Index].CharacterKey, Index);
+	}
+}
+
+const FRsSignificanceTier* URsSignificanceSubsystem::FindTier(const AActor* Actor) const
+{
+	const int32* Index = EntryIndices.Find(Actor);
+	if (Index && Tiers.IsValidIndex(Entries[*Index].Tier))
+	{
+		return &Tiers[Entries[*Index].Tier];
+	}
+	return nullptr;
+}
+
+bool URsSignificanceSubsystem::ShouldDeferViewModelUpdate(const AActor* Model, double LastUpdateTime, float& OutDelay) const
+{
+	const FRsSignificanceTier* Tier = FindTier(Model);
+	if (Tier == nullptr || Tier->ViewModelUpdateInterval <= 0.f)
+	{
+		return false;
+	}
+
+	OutDelay = LastUpdateTime + Tier->ViewModelUpdateInterval - GetWorld()->GetTimeSeconds();
+	return OutDelay > 0.f;
+}
+
+void URsSignificanceSubsystem::GetMostSignificantCharacters(int32 Count, TFunctionRef<bool(const ARsCharacterBase&)> Filter, TArray<ARsCharacterBase*>& OutCharacters) const
+{
+	OutCharacters.Reset();
+	if (Count <= 0)
+	{
+		return;
+	}
+	
+	TArray<TPair<float, ARsCharacterBase*>, TInlineAllocator<64>> Candidates;
+	for (const FEntry& Entry : Entries)
+	{
+		ARsCharacterBase* Character = Entry.Character.Get();
+		if (Character && Filter(*Character))
+		{
+			Candidates.Emplace(Entry.Score, Character);
+		}
+	}
+	
+	Algo::SortBy(Candidates, [](const TPair<float, ARsCharacterBase*>& Candidate) { return Candidate.Key; }, TGreater<>());
+	for (int32 Index = 0; Index < FMath::Min(Count, Candidates.Num()); ++Index)
+	{
+		OutCharacters.Add(Candidates[Index].Value);
+	}
+}
+
+void URsSignificanceSubsystem::DumpToLog() const
+{
+	TArray<int32, TInlineAllocator<8>> TierCounts;
+	TierCounts.SetNumZeroed(Tiers.Num());
+	for (const FEntry& Entry : Entries)
+	{
+		UE_LOG(LogTemp, Log, TEXT("RsSignificanceSubsystem: %s Score %.2f Tier %d"), *GetNameSafe(Entry.Character.Get()), Entry.Score, Entry.Tier);
+		if (TierCounts.IsValidIndex(Entry.Tier))
+		{
+			TierCounts[Entry.Tier]++;
+		}
+	}
+	for (int32 Index = 0; Index < TierCounts.Num(); ++Index)
+	{
+		UE_LOG(LogTemp, Log, TEXT("RsSignificanceSubsystem: Tier %d: %d characters"), Index, TierCounts[Index]);
+	}
+}
+
+void URsSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+	if (PlayerController == nullptr)
+	{
+		return;
+	}
+	
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	
+	const double Now = GetWorld()->GetTimeSeconds();
+	const int32 NumEvaluations = FMath::Min(MaxEvaluationsPerFrame, Entries.Num());
+	for (int32 Count = 0; Count < NumEvaluations; ++Count)
+	{
+		NextEvaluationIndex = NextEvaluationIndex % Entries.Num();
+		FEntry& Entry = Entries[NextEvaluationIndex++];
+		ARsCharacterBase* Character = Entry.Character.Get();
+		if (Character == nullptr)
+		{
+			continue;
+		}
+
+		Entry.Score = EvaluateScore(Entry, ViewLocation, Now);
+		int32 NewTier = Tiers.Num() - 1;
+		for (int32 Index = 0; Index < Tiers.Num(); ++Index)
+		{
+			if (Entry.Score >= Tiers[Index].MinScore)
+			{
+				NewTier = Index;
+				break;
+			}
+		}
+		
+		if (NewTier != Entry.Tier)
+		{
+			Entry.Tier = NewTier;
+			ApplyTier(*Character, Tiers[NewTier]);
+		}
+	}
+}
+
+bool URsSignificanceSubsystem::IsTickable() const
+{
+	return !Entries.IsEmpty() && !Tiers.IsEmpty();
+}
+
+TStatId URsSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+float URsSignificanceSubsystem::EvaluateScore(const FEntry& Entry, const FVector& ViewLocation, double Now) const
+{
+	const ARsCharacterBase* Character = Entry.Character.Get();
+	if (Character->IsPlayerControlled())
+	{
+		return 1.f + CombatBonus;
+	}
+	
+	const float Distance = FVector::Dist(Character->GetActorLocation(), ViewLocation);
+	float Score = FMath::Clamp(1.f - Distance / MaxSignificanceDistance, 0.f, 1.f);
+	if (!Character->WasRecentlyRendered(0.25f))
+	{
+		Score *= NotRenderedScale;
+	}
+	if (Now - Entry.LastCombatTime <= CombatMemoryTime)
+	{
+		Score += CombatBonus;
+	}
+	return Score;
+}
+
+void URsSignificanceSubsystem::ApplyTier(ARsCharacterBase& Character, const FRsSignificanceTier& Tier) const
+{
+	if (USkeletalMeshComponent* MeshComponent = Character.GetMesh())
+	{
+		MeshComponent->bEnableUpdateRateOptimizations = Tier.bEnableUpdateRateOptimizations;
+		MeshComponent->SetComponentTickInterval(Tier.AnimationTickInterval);
+	}
+	
+	if (UAbilitySystemComponent* AbilitySystemComponent = Character.GetAbilitySystemComponent())
+	{
+		AbilitySystemComponent->bSuppressGameplayCues = Tier.bSuppressGameplayCues;
+	}
+}
+
+void URsSignificanceSubsystem::HandleHealthChanged(const FOnAttributeChangeData& Data, TWeakObjectPtr<ARsCharacterBase> WeakCharacter)
+{
+	if (const int32* Index = EntryIndices.Find(WeakCharacter.Get()))
+	{
+		Entries[*Index].LastCombatTime = GetWorld()->GetTimeSeconds();
+	}
+}
@@ -0,0 +1,117 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsSignificanceSubsystem.generated.h"
+
+class ARsCharacterBase;
+struct FOnAttributeChangeData;
+
+// What a character is allowed to spend in one significance tier.
+USTRUCT()
+struct FRsSignificanceTier
+{
+	GENERATED_BODY()
+
+	// Characters with at least this score use this tier. Tiers are ordered from the highest score.
+	UPROPERTY(EditAnywhere, Config)
+	float MinScore = 0.f;
+
+	UPROPERTY(EditAnywhere, Config)
+	bool bEnableUpdateRateOptimizations = false;
+
+	// 0 means every frame.
+	UPROPERTY(EditAnywhere, Config)
+	float AnimationTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, Config)
+	bool bSuppressGameplayCues = false;
+
+	// Minimum time between two view model refreshes. 0 means immediate.
+	UPROPERTY(EditAnywhere, Config)
+	float ViewModelUpdateInterval = 0.f;
+
+	// AI LOD tier index used by characters in this tier.
+	UPROPERTY(EditAnywhere, Config)
+	int32 AILODTier = 0;
+};
+
+/**
+ * Decides which characters matter to the local view.
+ * Characters are scored by distance to the view, whether they were rendered recently, and whether they were recently in combat.
+ * The score picks a tier, which drives animation update rate, gameplay cue suppression, view model update rate and AI LOD.
+ * Not created on dedicated servers, where nothing is viewed.
+ */
+UCLASS(Config = Game)
+class RS_API URsSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsSignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	void RegisterCharacter(ARsCharacterBase* Character);
+	void UnregisterCharacter(ARsCharacterBase* Character);
+
+	// Returns nullptr if the actor is not registered yet.
+	const FRsSignificanceTier* FindTier(const AActor* Actor) const;
+	
+	// Returns true if a view model refresh of the model should wait, and how long.
+	bool ShouldDeferViewModelUpdate(const AActor* Model, double LastUpdateTime, float& OutDelay) const;
+
+	// Collects up to Count characters that pass the filter, most significant first.
+	void GetMostSignificantCharacters(int32 Count, TFunctionRef<bool(const ARsCharacterBase&)> Filter, TArray<ARsCharacterBase*>& OutCharacters) const;
+
+	void DumpToLog() const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<ARsCharacterBase> Character;
+		TObjectKey<AActor> CharacterKey;
+		FDelegateHandle HealthChangedDelegateHandle;
+		double LastCombatTime = -UE_DOUBLE_BIG_NUMBER;
+		float Score = 1.f;
+		int32 Tier = INDEX_NONE;
+	};
+
+	float EvaluateScore(const FEntry& Entry, const FVector& ViewLocation, double Now) const;
+	void ApplyTier(ARsCharacterBase& Character, const FRsSignificanceTier& Tier) const;
+	void HandleHealthChanged(const FOnAttributeChangeData& Data, TWeakObjectPtr<ARsCharacterBase> WeakCharacter);
+
+	UPROPERTY(Config)
+	TArray<FRsSignificanceTier> Tiers;
+
+	// Distance where the distance part of the score reaches 0.
+	UPROPERTY(Config)
+	float MaxSignificanceDistance = 6000.f;
+
+	// Score multiplier for characters that weren't rendered recently.
+	UPROPERTY(Config)
+	float NotRenderedScale = 0.4f;
+
+	// Score added while a character took damage within CombatMemoryTime.
+	UPROPERTY(Config)
+	float CombatBonus = 0.3f;
+
+	UPROPERTY(Config)
+	float CombatMemoryTime = 3.f;
+
+	UPROPERTY(Config)
+	int32 MaxEvaluationsPerFrame = 32;
+
+	TArray<FEntry> Entries;
+	TMap<TObjectKey<AActor>, int32> EntryIndices;
+	int32 NextEvaluationIndex = 0;
+};
@@ -1,5 +0,0 @@
-// Copyright 2024 Team BH.
-
-
-#include "RsUIManagerSubsystem.h"
-
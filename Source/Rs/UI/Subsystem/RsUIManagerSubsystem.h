@@ -1,17 +0,0 @@
-// Copyright 2024 Team BH.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameUIManagerSubsystem.h"
-#include "RsUIManagerSubsystem.generated.h"
-
-/**
- * 
- */
-UCLASS()
-class RS_API URsUIManagerSubsystem : public UGameUIManagerSubsystem
-{
-	GENERATED_BODY()
-	
-};
@@ -1,93 +0,0 @@
-// Copyright 2024 Team BH.
-
-
-#include "RsEnergySetViewModel.h"
-
-#include "AbilitySystemGlobals.h"
-#include "Rs/AbilitySystem/Attributes/RsEnergySet.h"
-
-URsEnergySetViewModel* URsEnergySetViewModel::CreateEnergySetViewModel(AActor* Model)
-{
-	URsEnergySetViewModel* ViewModel = NewObject<URsEnergySetViewModel>(Model);
-	ViewModel->Initialize();
-	return ViewModel;
-}
-
-void URsEnergySetViewModel::Initialize()
-{
-	const AActor* Model = Cast<AActor>(GetOuter());
-	if (UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Model))
-	{
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(URsEnergySet::GetMaxEnergyAttribute()).AddUObject(this, &ThisClass::MaxEnergyChanged);
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(URsEnergySet::GetCurrentEnergyAttribute()).AddUObject(this, &ThisClass::CurrentEnergyChanged);
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(URsEnergySet::GetEnergyRegenAttribute()).AddUObject(this, &ThisClass::EnergyRegenChanged);
-
-		bool bFound;
-		SetMaxEnergy(AbilitySystemComponent->GetGameplayAttributeValue(URsEnergySet::GetMaxEnergyAttribute(), bFound));
-		SetCurrentEnergy(AbilitySystemComponent->GetGameplayAttributeValue(URsEnergySet::GetCurrentEnergyAttribute(), bFound));
-		SetEnergyRegen(AbilitySystemComponent->GetGameplayAttributeValue(URsEnergySet::GetEnergyRegenAttribute(), bFound));
-	}
-}
-
-float URsEnergySetViewModel::GetCurrentEnergy() const
-{
-	return CurrentEnergy;
-}
-
-float URsEnergySetViewModel::GetMaxEnergy() const
-{
-	return CurrentEnergy;
-}
-
-float URsEnergySetViewModel::GetEnergyRegen() const
-{
-	return EnergyRegen;
-}
-
-void URsEnergySetViewModel::SetCurrentEnergy(float NewCurrentEnergy)
-{
-	if (UE_MVVM_SET_PROPERTY_VALUE(CurrentEnergy, NewCurrentEnergy))
-	{
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetEnergyPercent);
-	}
-}
-
-void URsEnergySetViewModel::SetMaxEnergy(float NewMaxEnergy)
-{
-	if (UE_MVVM_SET_PROPERTY_VALUE(MaxEnergy, NewMaxEnergy))
-	{
-		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetEnergyPercent);
-	}
-}
-
-void URsEnergySetViewModel::SetEnergyRegen(float NewEnergyRegen)
-{
-	UE_MVVM_SET_PROPERTY_VALUE(EnergyRegen, NewEnergyRegen);
-}
-
-float URsEnergySetViewModel::GetEnergyPercent() const
-{
-	if (MaxEnergy != 0)
-	{
-		return CurrentEnergy / MaxEnergy;
-	}
-	else
-	{
-		return 0;
-	}
-}
-
-void URsEnergySetViewModel::MaxEnergyChanged(const FOnAttributeChangeData& Data)
-{
-	SetMaxEnergy(Data.NewValue);
-}
-
-void URsEnergySetViewModel::CurrentEnergyChanged(const FOnAttributeChangeData& Data)
-{
-	SetCurrentEnergy(Data.NewValue);
-}
-
-void URsEnergySetViewModel::EnergyRegenChanged(const FOnAttributeChangeData& Data)
-{
-	SetEnergyRegen(Data.NewValue);
-}
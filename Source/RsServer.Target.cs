@@ -0,0 +1,17 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+// Dedicated server build. Leaves out the client-only RsUI module (widgets, view models, damage numbers, health bars),
+// and with it the direct UMG, CommonUI and ModelViewViewModel dependencies. CommonGame is still linked for the player controller and game instance bases.
+public class RsServerTarget : TargetRules
+{
+	public RsServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
+		ExtraModuleNames.Add("Rs");
+	}
+}
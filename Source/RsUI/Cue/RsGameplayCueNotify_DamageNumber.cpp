@@ -0,0 +1,27 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsGameplayCueNotify_DamageNumber.h"
+
+#include "Rs/Battle/RsBattleLibrary.h"
+#include "RsUI/RsUIStats.h"
+#include "RsUI/Subsystem/RsDamageNumberSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Cues Executed"), STAT_RsDamageCuesExecuted, STATGROUP_RsUI);
+
+bool URsGameplayCueNotify_DamageNumber::OnExecute_Implementation(AActor* MyTarget, const FGameplayCueParameters& Parameters) const
+{
+	INC_DWORD_STAT(STAT_RsDamageCuesExecuted);
+	
+	if (MyTarget == nullptr)
+	{
+		return false;
+	}
+
+	if (URsDamageNumberSubsystem* DamageNumberSubsystem = URsDamageNumberSubsystem::Get(MyTarget))
+	{
+		const FVector Location = Parameters.Location.IsZero() ? MyTarget->GetActorLocation() : FVector(Parameters.Location);
+		DamageNumberSubsystem->AddDamage(MyTarget, Location, Parameters.RawMagnitude, URsBattleLibrary::IsCriticalHitEffect(Parameters.EffectContext));
+	}
+	return Super::OnExecute_Implementation(MyTarget, Parameters);
+}
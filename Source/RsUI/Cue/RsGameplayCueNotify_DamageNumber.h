@@ -0,0 +1,20 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayCueNotify_Static.h"
+#include "RsGameplayCueNotify_DamageNumber.generated.h"
+
+/**
+ * Sends the damage of each hit to URsDamageNumberSubsystem, which sums hits per target into pooled widgets.
+ * Use as the parent of damage cues instead of spawning a floater actor per hit.
+ */
+UCLASS()
+class RSUI_API URsGameplayCueNotify_DamageNumber : public UGameplayCueNotify_Static
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool OnExecute_Implementation(AActor* MyTarget, const FGameplayCueParameters& Parameters) const override;
+};
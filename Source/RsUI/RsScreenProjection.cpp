@@ -0,0 +1,46 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsScreenProjection.h"
+
+#include "SceneView.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+
+bool FRsScreenProjection::Initialize(const APlayerController* PlayerController)
+{
+	const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+	if (LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr)
+	{
+		return false;
+	}
+	
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		return false;
+	}
+	ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	ViewRect = ProjectionData.GetConstrainedViewRect();
+	ViewportScale = UWidgetLayoutLibrary::GetViewportScale(PlayerController);
+	return ViewportScale > 0.f;
+}
+
+bool FRsScreenProjection::Project(const FVector& WorldLocation, FVector2D& OutPosition) const
+{
+	FVector2D ScreenPosition;
+	if (!FSceneView::ProjectWorldToScreen(WorldLocation, ViewRect, ViewProjectionMatrix, ScreenPosition))
+	{
+		return false;
+	}
+	
+	ScreenPosition -= FVector2D(ViewRect.Min);
+	if (ScreenPosition.X < 0.f || ScreenPosition.Y < 0.f || ScreenPosition.X > ViewRect.Width() || ScreenPosition.Y > ViewRect.Height())
+	{
+		return false;
+	}
+	OutPosition = ScreenPosition / ViewportScale;
+	return true;
+}
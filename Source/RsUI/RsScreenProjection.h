@@ -0,0 +1,25 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APlayerController;
+
+/**
+ * Projects many world locations into a player's widget space with one view projection.
+ * Initialize once per frame, then project every widget position with it.
+ */
+struct RSUI_API FRsScreenProjection
+{
+	// Returns false if the player has no view this frame.
+	bool Initialize(const APlayerController* PlayerController);
+
+	// Position in the player's viewport in slate units. Returns false behind the view or off screen.
+	bool Project(const FVector& WorldLocation, FVector2D& OutPosition) const;
+
+private:
+	FMatrix ViewProjectionMatrix = FMatrix::Identity;
+	FIntRect ViewRect;
+	float ViewportScale = 1.f;
+};
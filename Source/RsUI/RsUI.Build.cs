@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Widgets, view models and other client-only UI. Not built for dedicated server targets.
+public class RsUI : ModuleRules
+{
+	public RsUI(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+	
+		PublicDependencyModuleNames.AddRange(new string[]
+		{
+			"Core", 
+			"CoreUObject", 
+			"Engine", 
+			"Rs",
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[]
+		{
+			"UMG",
+			"Slate",
+			"SlateCore",
+			"GameplayAbilities", 
+			"GameplayTasks", 
+			"GameplayTags", 
+			"ModelViewViewModel",
+			"CommonUI",
+			"CommonGame",
+		});
+	}
+}
@@ -0,0 +1,24 @@
+// Copyright 2024 Team BH.
+
+#include "RsUI.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Modules/ModuleManager.h"
+#include "Rs/Party/RsPartyLibrary.h"
+
+void FRsUIModule::StartupModule()
+{
+	// Widgets aren't actors, so the party library can't find their player by ownership.
+	URsPartyLibrary::ResolveOwningPlayer.BindLambda([](const UObject* ContextObject) -> APlayerController*
+	{
+		const UUserWidget* Widget = Cast<UUserWidget>(ContextObject);
+		return Widget ? Widget->GetOwningPlayer() : nullptr;
+	});
+}
+
+void FRsUIModule::ShutdownModule()
+{
+	URsPartyLibrary::ResolveOwningPlayer.Unbind();
+}
+
+IMPLEMENT_MODULE(FRsUIModule, RsUI);
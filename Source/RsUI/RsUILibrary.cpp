@@ -0,0 +1,40 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsUILibrary.h"
+
+#include "PrimaryGameLayout.h"
+#include "Rs/Party/RsPartyComponent.h"
+#include "Rs/Party/RsPartyLibrary.h"
+#include "Rs/Player/RsPlayerController.h"
+#include "RsUI/Subsystem/RsUIManagerSubsystem.h"
+
+void URsUILibrary::ShowGameHUD(UObject* WorldContextObject)
+{
+	if (UPrimaryGameLayout* GameHUD = UPrimaryGameLayout::GetPrimaryGameLayoutForPrimaryPlayer(WorldContextObject))
+	{
+		GameHUD->SetVisibility(ESlateVisibility::Visible);
+	}
+}
+
+void URsUILibrary::HideGameHUD(UObject* WorldContextObject)
+{
+	if (UPrimaryGameLayout* GameHUD = UPrimaryGameLayout::GetPrimaryGameLayoutForPrimaryPlayer(WorldContextObject))
+	{
+		GameHUD->SetVisibility(ESlateVisibility::Hidden);
+	}
+}
+
+URsCharacterViewModel* URsUILibrary::GetPartyMemberViewModel(UObject* WorldContextObject, int32 MemberIndex)
+{
+	const ARsPlayerController* RsPlayerController = URsPartyLibrary::FindPartyController(WorldContextObject);
+	ARsPlayerCharacter* Member = RsPlayerController ? RsPlayerController->GetPartyComponent()->GetPartyMember(MemberIndex) : nullptr;
+	if (Member == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Created here when pre-warming was off while the member joined.
+	URsUIManagerSubsystem* UIManager = URsUIManagerSubsystem::Get(WorldContextObject);
+	return UIManager ? UIManager->FindOrCreateCharacterViewModel(Member) : nullptr;
+}
@@ -6,11 +6,13 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "RsUILibrary.generated.h"
 
+class URsCharacterViewModel;
+
 /**
  * 
  */
 UCLASS()
-class RS_API URsUILibrary : public UBlueprintFunctionLibrary
+class RSUI_API URsUILibrary : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
@@ -20,4 +22,8 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Rs UI Library", meta = (WorldContext = "WorldContextObject"))
 	static void HideGameHUD(UObject* WorldContextObject);
+
+	// Returns the view model kept for the party member, so widgets don't rebuild one on every switch.
+	UFUNCTION(BlueprintCallable, Category = "Rs UI Library", meta = (WorldContext = "WorldContextObject"))
+	static URsCharacterViewModel* GetPartyMemberViewModel(UObject* WorldContextObject, int32 MemberIndex);
 };
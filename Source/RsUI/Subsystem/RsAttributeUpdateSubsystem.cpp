@@ -0,0 +1,239 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsAttributeUpdateSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/CoreDelegates.h"
+#include "Rs/System/RsSignificanceSubsystem.h"
+#include "RsUI/RsUIStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Attribute Update Flush"), STAT_RsAttributeUpdateFlush, STATGROUP_RsUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attribute Notifications Received"), STAT_RsAttributeNotificationsReceived, STATGROUP_RsUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attribute Notifications Delivered"), STAT_RsAttributeNotificationsDelivered, STATGROUP_RsUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attribute Listeners"), STAT_RsAttributeListeners, STATGROUP_RsUI);
+
+URsAttributeUpdateSubsystem* URsAttributeUpdateSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsAttributeUpdateSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsAttributeUpdateSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && !IsRunningDedicatedServer();
+}
+
+bool URsAttributeUpdateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsAttributeUpdateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Slate pre-tick runs after the world tick and before the widget prepass. Without Slate, flush at the end of the frame.
+	if (FSlateApplication::IsInitialized())
+	{
+		PreTickHandle = FSlateApplication::Get().OnPreTick().AddUObject(this, &ThisClass::HandleSlatePreTick);
+	}
+	else
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &ThisClass::Flush);
+	}
+}
+
+void URsAttributeUpdateSubsystem::Deinitialize()
+{
+	if (PreTickHandle.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnPreTick().Remove(PreTickHandle);
+	}
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+	for (const TPair<FBindingKey, FBinding>& Binding : Bindings)
+	{
+		if (UAbilitySystemComponent* AbilitySystemComponent = Binding.Key.AbilitySystemComponent.ResolveObjectPtr())
+		{
+			AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Binding.Key.Attribute).Remove(Binding.Value.DelegateHandle);
+		}
+	}
+	Bindings.Reset();
+	Listeners.Reset();
+	DirtyListeners.Reset();
+	SET_DWORD_STAT(STAT_RsAttributeListeners, 0);
+	
+	Super::Deinitialize();
+}
+
+int32 URsAttributeUpdateSubsystem::RegisterListener(UObject* Listener, UAbilitySystemComponent* AbilitySystemComponent, const AActor* Model, TConstArrayView<FGameplayAttribute> Attributes, FRsAttributeValueDelegate Delegate)
+{
+	if (Listener == nullptr || AbilitySystemComponent == nullptr || Attributes.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+	if (Attributes.Num() > 32)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RsAttributeUpdateSubsystem::RegisterListener: %s listens to more than 32 attributes"), *GetNameSafe(Listener));
+		return INDEX_NONE;
+	}
+
+	FListener NewListener;
+	NewListener.Listener = Listener;
+	NewListener.AbilitySystemComponent = AbilitySystemComponent;
+	NewListener.AbilitySystemKey = AbilitySystemComponent;
+	NewListener.Model = Model;
+	NewListener.Attributes = Attributes;
+	NewListener.Delegate = MoveTemp(Delegate);
+	const int32 ListenerHandle = Listeners.Add(MoveTemp(NewListener));
+
+	for (const FGameplayAttribute& Attribute : Attributes)
+	{
+		FBinding& Binding = Bindings.FindOrAdd({ AbilitySystemComponent, Attribute });
+		if (!Binding.DelegateHandle.IsValid())
+		{
+			Binding.DelegateHandle = AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(this, &ThisClass::HandleAttributeChanged, TWeakObjectPtr<UAbilitySystemComponent>(AbilitySystemComponent));
+		}
+		Binding.ListenerHandles.Add(ListenerHandle);
+	}
+	
+	INC_DWORD_STAT(STAT_RsAttributeListeners);
+	return ListenerHandle;
+}
+
+void URsAttributeUpdateSubsystem::UnregisterListener(int32 ListenerHandle, const UObject* Listener)
+{
+	if (Listeners.IsValidIndex(ListenerHandle) && Listeners[ListenerHandle].Listener == Listener)
+	{
+		RemoveListener(ListenerHandle);
+	}
+}
+
+void URsAttributeUpdateSubsystem::RemoveListener(int32 ListenerHandle)
+{
+	const FListener& Listener = Listeners[ListenerHandle];
+	for (const FGameplayAttribute& Attribute : Listener.Attributes)
+	{
+		const FBindingKey Key = { Listener.AbilitySystemKey, Attribute };
+		FBinding* Binding = Bindings.Find(Key);
+		if (Binding == nullptr)
+		{
+			continue;
+		}
+		
+		Binding->ListenerHandles.RemoveSingleSwap(ListenerHandle);
+		if (Binding->ListenerHandles.IsEmpty())
+		{
+			if (UAbilitySystemComponent* AbilitySystemComponent = Listener.AbilitySystemComponent.Get())
+			{
+				AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).Remove(Binding->DelegateHandle);
+			}
+			Bindings.Remove(Key);
+		}
+	}
+	
+	Listeners.RemoveAt(ListenerHandle);
+	DEC_DWORD_STAT(STAT_RsAttributeListeners);
+}
+
+void URsAttributeUpdateSubsystem::HandleAttributeChanged(const FOnAttributeChangeData& ChangeData, TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent)
+{
+	++NotificationsReceived;
+	INC_DWORD_STAT(STAT_RsAttributeNotificationsReceived);
+
+	const FBinding* Binding = Bindings.Find({ AbilitySystemComponent.Get(), ChangeData.Attribute });
+	if (Binding == nullptr)
+	{
+		return;
+	}
+
+	for (const int32 ListenerHandle : Binding->ListenerHandles)
+	{
+		FListener& Listener = Listeners[ListenerHandle];
+		const int32 AttributeIndex = Listener.Attributes.IndexOfByKey(ChangeData.Attribute);
+		if (AttributeIndex == INDEX_NONE)
+		{
+			continue;
+		}
+		
+		if (Listener.DirtyMask == 0)
+		{
+			DirtyListeners.Add(ListenerHandle);
+		}
+		Listener.DirtyMask |= 1u << AttributeIndex;
+	}
+}
+
+void URsAttributeUpdateSubsystem::HandleSlatePreTick(float DeltaTime)
+{
+	Flush();
+}
+
+void URsAttributeUpdateSubsystem::Flush()
+{
+	if (DirtyListeners.IsEmpty())
+	{
+		return;
+	}
+	
+	SCOPE_CYCLE_COUNTER(STAT_RsAttributeUpdateFlush);
+
+	const UWorld* World = GetWorld();
+	const double CurrentTime = World->GetTimeSeconds();
+	const URsSignificanceSubsystem* SignificanceSubsystem = World->GetSubsystem<URsSignificanceSubsystem>();
+
+	// Delegates may register or unregister listeners, so iterate a copy.
+	TArray<int32> ListenersToFlush = MoveTemp(DirtyListeners);
+	DirtyListeners.Reset();
+	
+	for (const int32 ListenerHandle : ListenersToFlush)
+	{
+		if (!Listeners.IsValidIndex(ListenerHandle) || Listeners[ListenerHandle].DirtyMask == 0)
+		{
+			continue;
+		}
+
+		FListener& Listener = Listeners[ListenerHandle];
+		const UAbilitySystemComponent* AbilitySystemComponent = Listener.AbilitySystemComponent.Get();
+		if (!Listener.Listener.IsValid() || AbilitySystemComponent == nullptr)
+		{
+			RemoveListener(ListenerHandle);
+			continue;
+		}
+
+		// Insignificant models wait for their tier's interval, and keep collecting changes meanwhile.
+		float Delay = 0.f;
+		if (SignificanceSubsystem && SignificanceSubsystem->ShouldDeferViewModelUpdate(Listener.Model.Get(), Listener.LastDeliveryTime, Delay))
+		{
+			DirtyListeners.Add(ListenerHandle);
+			continue;
+		}
+
+		// Copy, since the delegate may unregister this listener.
+		const TArray<FGameplayAttribute, TInlineAllocator<4>> Attributes = Listener.Attributes;
+		const FRsAttributeValueDelegate Delegate = Listener.Delegate;
+		const uint32 DirtyMask = Listener.DirtyMask;
+		Listener.DirtyMask = 0;
+		Listener.LastDeliveryTime = CurrentTime;
+		
+		for (int32 AttributeIndex = 0; AttributeIndex < Attributes.Num(); ++AttributeIndex)
+		{
+			if (DirtyMask & (1u << AttributeIndex))
+			{
+				bool bFound = false;
+				const float Value = AbilitySystemComponent->GetGameplayAttributeValue(Attributes[AttributeIndex], bFound);
+				if (bFound)
+				{
+					Delegate.ExecuteIfBound(Attributes[AttributeIndex], Value);
+					++NotificationsDelivered;
+					INC_DWORD_STAT(STAT_RsAttributeNotificationsDelivered);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,92 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsAttributeUpdateSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+struct FOnAttributeChangeData;
+
+DECLARE_DELEGATE_TwoParams(FRsAttributeValueDelegate, const FGameplayAttribute& /*Attribute*/, float /*NewValue*/);
+
+/**
+ * Collects attribute changes for view models, and delivers them once per frame before Slate prepass.
+ * Each ability system attribute is bound once, however many view models listen to it.
+ * A listener receives the latest value of every attribute that changed since its last delivery, no matter how many times it changed.
+ * Listeners of insignificant models are delivered at the rate of their significance tier.
+ * Not created on dedicated servers.
+ */
+UCLASS()
+class RSUI_API URsAttributeUpdateSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsAttributeUpdateSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Returns a listener handle. Model is used to find the significance tier, and may be null.
+	int32 RegisterListener(UObject* Listener, UAbilitySystemComponent* AbilitySystemComponent, const AActor* Model, TConstArrayView<FGameplayAttribute> Attributes, FRsAttributeValueDelegate Delegate);
+	// The listener is checked, as handles of removed listeners are reused.
+	void UnregisterListener(int32 ListenerHandle, const UObject* Listener);
+
+	// Delivers every pending change now.
+	void Flush();
+
+	// Totals since the world started.
+	int64 GetNotificationsReceived() const { return NotificationsReceived; }
+	int64 GetNotificationsDelivered() const { return NotificationsDelivered; }
+
+private:
+	struct FListener
+	{
+		TWeakObjectPtr<UObject> Listener;
+		TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+		// Still identifies the bindings after the ability system is gone.
+		TObjectKey<UAbilitySystemComponent> AbilitySystemKey;
+		TWeakObjectPtr<const AActor> Model;
+		TArray<FGameplayAttribute, TInlineAllocator<4>> Attributes;
+		FRsAttributeValueDelegate Delegate;
+		// Bit per entry of Attributes.
+		uint32 DirtyMask = 0;
+		double LastDeliveryTime = 0.0;
+	};
+
+	struct FBindingKey
+	{
+		TObjectKey<UAbilitySystemComponent> AbilitySystemComponent;
+		FGameplayAttribute Attribute;
+
+		bool operator==(const FBindingKey& Other) const { return AbilitySystemComponent == Other.AbilitySystemComponent && Attribute == Other.Attribute; }
+		friend uint32 GetTypeHash(const FBindingKey& Key) { return HashCombine(GetTypeHash(Key.AbilitySystemComponent), GetTypeHash(Key.Attribute)); }
+	};
+
+	struct FBinding
+	{
+		FDelegateHandle DelegateHandle;
+		TArray<int32, TInlineAllocator<4>> ListenerHandles;
+	};
+
+	void HandleAttributeChanged(const FOnAttributeChangeData& ChangeData, TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent);
+	void HandleSlatePreTick(float DeltaTime);
+	void RemoveListener(int32 ListenerHandle);
+
+	TSparseArray<FListener> Listeners;
+	TMap<FBindingKey, FBinding> Bindings;
+
+	// Listeners with a dirty attribute. May contain removed handles.
+	TArray<int32> DirtyListeners;
+
+	FDelegateHandle PreTickHandle;
+	FDelegateHandle EndFrameHandle;
+
+	int64 NotificationsReceived = 0;
+	int64 NotificationsDelivered = 0;
+};
@@ -0,0 +1,192 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsDamageNumberSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "RsUI/RsScreenProjection.h"
+#include "RsUI/RsUIStats.h"
+#include "RsUI/Widget/RsDamageNumberWidget.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Number Update"), STAT_RsDamageNumberUpdate, STATGROUP_RsUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Numbers Shown"), STAT_RsDamageNumbersShown, STATGROUP_RsUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Numbers Visible"), STAT_RsDamageNumbersVisible, STATGROUP_RsUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage Number Widgets"), STAT_RsDamageNumberWidgets, STATGROUP_RsUI);
+
+URsDamageNumberSubsystem* URsDamageNumberSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsDamageNumberSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsDamageNumberSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && !IsRunningDedicatedServer();
+}
+
+bool URsDamageNumberSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsDamageNumberSubsystem::Deinitialize()
+{
+	for (FRsDamageNumberSlot& Slot : Slots)
+	{
+		Slot.Widget->RemoveFromParent();
+	}
+	Slots.Reset();
+	PendingDamages.Reset();
+	NumActiveSlots = 0;
+	SET_DWORD_STAT(STAT_RsDamageNumberWidgets, 0);
+	
+	Super::Deinitialize();
+}
+
+void URsDamageNumberSubsystem::AddDamage(const AActor* Target, const FVector& Location, float Damage, bool bCritical)
+{
+	if (Target == nullptr || DamageNumberWidgetClass.IsNull())
+	{
+		return;
+	}
+
+	FPendingDamage& PendingDamage = PendingDamages.FindOrAdd(Target);
+	if (PendingDamage.HitCount == 0)
+	{
+		PendingDamage.Location = Location;
+		PendingDamage.ShowTime = GetWorld()->GetTimeSeconds() + AggregationWindow;
+	}
+	PendingDamage.Damage += Damage;
+	PendingDamage.bCritical |= bCritical;
+	++PendingDamage.HitCount;
+}
+
+void URsDamageNumberSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SCOPE_CYCLE_COUNTER(STAT_RsDamageNumberUpdate);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (auto It = PendingDamages.CreateIterator(); It; ++It)
+	{
+		if (It.Value().ShowTime <= Now)
+		{
+			ShowDamageNumber(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+	UpdatePositions(Now);
+}
+
+bool URsDamageNumberSubsystem::IsTickable() const
+{
+	return !PendingDamages.IsEmpty() || NumActiveSlots > 0;
+}
+
+TStatId URsDamageNumberSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsDamageNumberSubsystem, STATGROUP_Tickables);
+}
+
+void URsDamageNumberSubsystem::ShowDamageNumber(const FPendingDamage& PendingDamage)
+{
+	FRsDamageNumberSlot* Slot = AcquireSlot();
+	if (Slot == nullptr)
+	{
+		return;
+	}
+
+	if (!Slot->bActive)
+	{
+		Slot->bActive = true;
+		++NumActiveSlots;
+	}
+	Slot->WorldLocation = PendingDamage.Location;
+	Slot->HideTime = GetWorld()->GetTimeSeconds() + DisplayDuration;
+	Slot->Widget->OnDamageNumberShown(PendingDamage.Damage, PendingDamage.bCritical, PendingDamage.HitCount);
+	INC_DWORD_STAT(STAT_RsDamageNumbersShown);
+}
+
+FRsDamageNumberSlot* URsDamageNumberSubsystem::AcquireSlot()
+{
+	FRsDamageNumberSlot* OldestSlot = nullptr;
+	for (FRsDamageNumberSlot& Slot : Slots)
+	{
+		if (!Slot.bActive)
+		{
+			return &Slot;
+		}
+		if (OldestSlot == nullptr || Slot.HideTime < OldestSlot->HideTime)
+		{
+			OldestSlot = &Slot;
+		}
+	}
+
+	if (Slots.Num() >= MaxDamageNumbers)
+	{
+		return OldestSlot;
+	}
+	
+	APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+	UClass* WidgetClass = DamageNumberWidgetClass.LoadSynchronous();
+	if (PlayerController == nullptr || WidgetClass == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("URsDamageNumberSubsystem::AcquireSlot: Can't create a damage number of class %s"), *DamageNumberWidgetClass.ToString());
+		return nullptr;
+	}
+	
+	URsDamageNumberWidget* Widget = CreateWidget<URsDamageNumberWidget>(PlayerController, WidgetClass);
+	if (Widget == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Anchored to the top left, so the render translation is the position on screen.
+	Widget->SetAnchorsInViewport(FAnchors(0.f, 0.f));
+	Widget->SetAlignmentInViewport(FVector2D(0.5f, 0.5f));
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	Widget->AddToPlayerScreen();
+
+	FRsDamageNumberSlot& Slot = Slots.AddDefaulted_GetRef();
+	Slot.Widget = Widget;
+	INC_DWORD_STAT(STAT_RsDamageNumberWidgets);
+	return &Slot;
+}
+
+void URsDamageNumberSubsystem::UpdatePositions(double Now)
+{
+	FRsScreenProjection Projection;
+	const bool bHasView = Projection.Initialize(UGameplayStatics::GetPlayerController(this, 0));
+
+	int32 NumVisible = 0;
+	for (FRsDamageNumberSlot& Slot : Slots)
+	{
+		if (Slot.bActive && Slot.HideTime <= Now)
+		{
+			Slot.bActive = false;
+			--NumActiveSlots;
+		}
+		
+		FVector2D ScreenPosition;
+		const bool bOnScreen = Slot.bActive && bHasView && Projection.Project(Slot.WorldLocation, ScreenPosition);
+		if (bOnScreen)
+		{
+			Slot.Widget->SetRenderTranslation(ScreenPosition);
+			++NumVisible;
+		}
+		SetSlotVisible(Slot, bOnScreen);
+	}
+	SET_DWORD_STAT(STAT_RsDamageNumbersVisible, NumVisible);
+}
+
+void URsDamageNumberSubsystem::SetSlotVisible(FRsDamageNumberSlot& Slot, bool bNewVisible)
+{
+	if (Slot.bVisible != bNewVisible)
+	{
+		Slot.bVisible = bNewVisible;
+		Slot.Widget->SetVisibility(bNewVisible ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+}
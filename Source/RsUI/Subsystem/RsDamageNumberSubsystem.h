@@ -0,0 +1,85 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsDamageNumberSubsystem.generated.h"
+
+class URsDamageNumberWidget;
+
+USTRUCT()
+struct FRsDamageNumberSlot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<URsDamageNumberWidget> Widget;
+
+	FVector WorldLocation = FVector::ZeroVector;
+	double HideTime = 0.0;
+	bool bActive = false;
+	bool bVisible = false;
+};
+
+/**
+ * Shows floating damage numbers from a fixed-size widget pool.
+ * Hits on the same target within AggregationWindow are summed into one number.
+ * When every widget is in use, the one closest to hiding is reused.
+ * Not created on dedicated servers.
+ */
+UCLASS(Config = Game)
+class RSUI_API URsDamageNumberSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsDamageNumberSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	void AddDamage(const AActor* Target, const FVector& Location, float Damage, bool bCritical);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FPendingDamage
+	{
+		FVector Location = FVector::ZeroVector;
+		float Damage = 0.f;
+		int32 HitCount = 0;
+		bool bCritical = false;
+		double ShowTime = 0.0;
+	};
+
+	void ShowDamageNumber(const FPendingDamage& PendingDamage);
+	FRsDamageNumberSlot* AcquireSlot();
+	void UpdatePositions(double Now);
+	void SetSlotVisible(FRsDamageNumberSlot& Slot, bool bNewVisible);
+
+	UPROPERTY(Config)
+	TSoftClassPtr<URsDamageNumberWidget> DamageNumberWidgetClass;
+
+	// Pool size. No more numbers than this are ever on screen.
+	UPROPERTY(Config)
+	int32 MaxDamageNumbers = 32;
+
+	// Hits on one target within this many seconds show as one number.
+	UPROPERTY(Config)
+	float AggregationWindow = 0.1f;
+
+	// Seconds a number stays on screen. Should cover the widget's animation.
+	UPROPERTY(Config)
+	float DisplayDuration = 1.f;
+
+	UPROPERTY()
+	TArray<FRsDamageNumberSlot> Slots;
+
+	TMap<TObjectKey<AActor>, FPendingDamage> PendingDamages;
+	int32 NumActiveSlots = 0;
+};
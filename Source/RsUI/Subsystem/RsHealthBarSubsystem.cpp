@@ -0,0 +1,257 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsHealthBarSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Rs/AbilitySystem/Attributes/RsHealthSet.h"
+#include "Rs/Character/RsEnemyCharacter.h"
+#include "Rs/System/RsSignificanceSubsystem.h"
+#include "RsUI/RsScreenProjection.h"
+#include "RsUI/RsUIStats.h"
+#include "RsUI/Subsystem/RsUIManagerSubsystem.h"
+#include "RsUI/Widget/RsHealthBarWidget.h"
+
+DECLARE_CYCLE_STAT(TEXT("Health Bar Assignment"), STAT_RsHealthBarAssignment, STATGROUP_RsUI);
+DECLARE_CYCLE_STAT(TEXT("Health Bar Projection"), STAT_RsHealthBarProjection, STATGROUP_RsUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Health Bars Visible"), STAT_RsHealthBarsVisible, STATGROUP_RsUI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Health Bar Widgets"), STAT_RsHealthBarWidgets, STATGROUP_RsUI);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRsHealthBarsEnable(
+	TEXT("rs.HealthBars.Enable"),
+	TEXT("rs.HealthBars.Enable <0|1>. Turns pooled enemy health bars off or on. Compare stat RsUI and stat Slate both ways, e.g. with rs.Crowd.Spawn 150."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		URsHealthBarSubsystem* HealthBarSubsystem = World ? World->GetSubsystem<URsHealthBarSubsystem>() : nullptr;
+		if (HealthBarSubsystem == nullptr || Args.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("rs.HealthBars.Enable: Needs a game world and 0 or 1"));
+			return;
+		}
+		HealthBarSubsystem->SetEnabled(FCString::Atoi(*Args[0]) != 0);
+	}));
+
+URsHealthBarSubsystem* URsHealthBarSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<URsHealthBarSubsystem>();
+	}
+	return nullptr;
+}
+
+bool URsHealthBarSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && !IsRunningDedicatedServer();
+}
+
+bool URsHealthBarSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URsHealthBarSubsystem::Deinitialize()
+{
+	for (FRsHealthBarSlot& Slot : Slots)
+	{
+		Slot.Widget->RemoveFromParent();
+	}
+	Slots.Reset();
+	SET_DWORD_STAT(STAT_RsHealthBarWidgets, 0);
+	
+	Super::Deinitialize();
+}
+
+void URsHealthBarSubsystem::SetEnabled(bool bNewEnabled)
+{
+	if (bEnabled == bNewEnabled)
+	{
+		return;
+	}
+	
+	bEnabled = bNewEnabled;
+	if (!bEnabled)
+	{
+		for (FRsHealthBarSlot& Slot : Slots)
+		{
+			ReleaseSlot(Slot);
+		}
+	}
+	RequestAssignment();
+}
+
+void URsHealthBarSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AssignmentTimer -= DeltaTime;
+	if (AssignmentTimer <= 0.f)
+	{
+		AssignmentTimer = AssignmentInterval;
+		AssignHealthBars();
+	}
+	UpdatePositions();
+}
+
+bool URsHealthBarSubsystem::IsTickable() const
+{
+	return bEnabled && !HealthBarWidgetClass.IsNull();
+}
+
+TStatId URsHealthBarSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URsHealthBarSubsystem, STATGROUP_Tickables);
+}
+
+void URsHealthBarSubsystem::AssignHealthBars()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RsHealthBarAssignment);
+	
+	const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+	const URsSignificanceSubsystem* SignificanceSubsystem = URsSignificanceSubsystem::Get(this);
+	if (PlayerController == nullptr || SignificanceSubsystem == nullptr)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	const double MaxDistanceSquared = FMath::Square(MaxHealthBarDistance);
+	
+	TArray<ARsCharacterBase*> Targets;
+	SignificanceSubsystem->GetMostSignificantCharacters(MaxHealthBars, [&ViewLocation, MaxDistanceSquared](const ARsCharacterBase& Character)
+	{
+		if (!Character.IsA<ARsEnemyCharacter>() || Character.IsHidden() || FVector::DistSquared(Character.GetActorLocation(), ViewLocation) > MaxDistanceSquared)
+		{
+			return false;
+		}
+		const UAbilitySystemComponent* AbilitySystemComponent = Character.GetAbilitySystemComponent();
+		return AbilitySystemComponent && AbilitySystemComponent->GetNumericAttribute(URsHealthSet::GetCurrentHealthAttribute()) > 0.f;
+	}, Targets);
+
+	// Bars that keep their target are left alone, so their view models don't rebind.
+	for (FRsHealthBarSlot& Slot : Slots)
+	{
+		ARsCharacterBase* Target = Slot.Target.Get();
+		if (Target && Targets.RemoveSwap(Target) > 0)
+		{
+			continue;
+		}
+		if (!Slot.Target.IsExplicitlyNull())
+		{
+			ReleaseSlot(Slot);
+		}
+	}
+
+	URsUIManagerSubsystem* UIManager = URsUIManagerSubsystem::Get(this);
+	for (ARsCharacterBase* Target : Targets)
+	{
+		FRsHealthBarSlot* Slot = UIManager ? AcquireSlot() : nullptr;
+		if (Slot == nullptr)
+		{
+			break;
+		}
+		Slot->Target = Target;
+		Slot->Widget->SetViewModel(UIManager->FindOrCreateCharacterViewModel(Target));
+	}
+}
+
+void URsHealthBarSubsystem::UpdatePositions()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RsHealthBarProjection);
+	
+	// One view projection for every bar, instead of a full projection per widget.
+	FRsScreenProjection Projection;
+	if (!Projection.Initialize(UGameplayStatics::GetPlayerController(this, 0)))
+	{
+		return;
+	}
+
+	int32 NumVisible = 0;
+	for (FRsHealthBarSlot& Slot : Slots)
+	{
+		const ARsCharacterBase* Target = Slot.Target.Get();
+		if (Target == nullptr)
+		{
+			if (!Slot.Target.IsExplicitlyNull())
+			{
+				ReleaseSlot(Slot);
+			}
+			continue;
+		}
+
+		const float HalfHeight = Target->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		const FVector WorldLocation = Target->GetActorLocation() + FVector(0.f, 0.f, HalfHeight + HeightOffset);
+		FVector2D ScreenPosition;
+		const bool bOnScreen = Projection.Project(WorldLocation, ScreenPosition);
+		if (bOnScreen)
+		{
+			// Render translation doesn't invalidate layout the way a viewport slot position does.
+			Slot.Widget->SetRenderTranslation(ScreenPosition);
+			++NumVisible;
+		}
+		SetSlotVisible(Slot, bOnScreen);
+	}
+	SET_DWORD_STAT(STAT_RsHealthBarsVisible, NumVisible);
+}
+
+FRsHealthBarSlot* URsHealthBarSubsystem::AcquireSlot()
+{
+	for (FRsHealthBarSlot& Slot : Slots)
+	{
+		if (Slot.Target.IsExplicitlyNull())
+		{
+			return &Slot;
+		}
+	}
+	
+	if (Slots.Num() >= MaxHealthBars)
+	{
+		return nullptr;
+	}
+
+	APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+	UClass* WidgetClass = HealthBarWidgetClass.LoadSynchronous();
+	if (PlayerController == nullptr || WidgetClass == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("URsHealthBarSubsystem::AcquireSlot: Can't create a health bar of class %s"), *HealthBarWidgetClass.ToString());
+		return nullptr;
+	}
+
+	URsHealthBarWidget* Widget = CreateWidget<URsHealthBarWidget>(PlayerController, WidgetClass);
+	if (Widget == nullptr)
+	{
+		return nullptr;
+	}
+	
+	// Anchored to the top left, so the render translation is the position on screen.
+	Widget->SetAnchorsInViewport(FAnchors(0.f, 0.f));
+	Widget->SetAlignmentInViewport(FVector2D(0.5f, 1.f));
+	Widget->SetDesiredSizeInViewport(HealthBarSize);
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	Widget->AddToPlayerScreen();
+
+	FRsHealthBarSlot& Slot = Slots.AddDefaulted_GetRef();
+	Slot.Widget = Widget;
+	INC_DWORD_STAT(STAT_RsHealthBarWidgets);
+	return &Slot;
+}
+
+void URsHealthBarSubsystem::ReleaseSlot(FRsHealthBarSlot& Slot)
+{
+	Slot.Target = nullptr;
+	Slot.Widget->SetViewModel(nullptr);
+	SetSlotVisible(Slot, false);
+}
+
+void URsHealthBarSubsystem::SetSlotVisible(FRsHealthBarSlot& Slot, bool bNewVisible)
+{
+	if (Slot.bVisible != bNewVisible)
+	{
+		Slot.bVisible = bNewVisible;
+		Slot.Widget->SetVisibility(bNewVisible ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+}
@@ -0,0 +1,88 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RsHealthBarSubsystem.generated.h"
+
+class ARsCharacterBase;
+class URsHealthBarWidget;
+
+USTRUCT()
+struct FRsHealthBarSlot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<URsHealthBarWidget> Widget;
+
+	TWeakObjectPtr<ARsCharacterBase> Target;
+	bool bVisible = false;
+};
+
+/**
+ * Shows enemy health bars from a fixed-size widget pool.
+ * Bars go to the most significant living enemies in range, and are reassigned at a fixed interval.
+ * View models come from the URsUIManagerSubsystem cache, so reassigning a bar doesn't create or bind anything new.
+ * Every visible bar is positioned in one projection pass per frame, using render translation so no layout is invalidated.
+ * Not created on dedicated servers.
+ */
+UCLASS(Config = Game)
+class RSUI_API URsHealthBarSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsHealthBarSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// Health bars can be turned off entirely, e.g. for capturing a baseline.
+	void SetEnabled(bool bNewEnabled);
+	bool IsEnabled() const { return bEnabled; }
+
+	// Reassigns bars now instead of waiting for the next interval.
+	void RequestAssignment() { AssignmentTimer = 0.f; }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void AssignHealthBars();
+	void UpdatePositions();
+	FRsHealthBarSlot* AcquireSlot();
+	void ReleaseSlot(FRsHealthBarSlot& Slot);
+	void SetSlotVisible(FRsHealthBarSlot& Slot, bool bNewVisible);
+
+	UPROPERTY(Config)
+	TSoftClassPtr<URsHealthBarWidget> HealthBarWidgetClass;
+
+	// Pool size. No more bars than this are ever created.
+	UPROPERTY(Config)
+	int32 MaxHealthBars = 20;
+
+	UPROPERTY(Config)
+	float MaxHealthBarDistance = 3000.f;
+
+	// Seconds between two reassignments.
+	UPROPERTY(Config)
+	float AssignmentInterval = 0.2f;
+
+	// Bars are anchored this far above the character's capsule.
+	UPROPERTY(Config)
+	float HeightOffset = 20.f;
+
+	UPROPERTY(Config)
+	FVector2D HealthBarSize = FVector2D(120.f, 16.f);
+
+	UPROPERTY()
+	TArray<FRsHealthBarSlot> Slots;
+
+	float AssignmentTimer = 0.f;
+	bool bEnabled = true;
+};
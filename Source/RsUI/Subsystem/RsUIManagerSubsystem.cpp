@@ -0,0 +1,90 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsUIManagerSubsystem.h"
+
+#include "Engine/GameInstance.h"
+#include "Rs/Character/RsPlayerCharacter.h"
+#include "Rs/Party/RsPartyComponent.h"
+#include "RsUI/RsUIStats.h"
+#include "RsUI/ViewModel/RsCharacterViewModel.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Character View Models"), STAT_RsCharacterViewModels, STATGROUP_RsUI);
+
+URsUIManagerSubsystem* URsUIManagerSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return UGameInstance::GetSubsystem<URsUIManagerSubsystem>(World->GetGameInstance());
+	}
+	return nullptr;
+}
+
+void URsUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	URsPartyComponent::OnPrewarmPartyMember.AddUObject(this, &ThisClass::HandlePrewarmPartyMember);
+}
+
+void URsUIManagerSubsystem::Deinitialize()
+{
+	URsPartyComponent::OnPrewarmPartyMember.RemoveAll(this);
+
+	for (const TPair<TWeakObjectPtr<ARsCharacterBase>, TObjectPtr<URsCharacterViewModel>>& Pair : CharacterViewModels)
+	{
+		if (ARsCharacterBase* Character = Pair.Key.Get())
+		{
+			Character->OnEndPlay.RemoveDynamic(this, &ThisClass::HandleCharacterEndPlay);
+		}
+		Pair.Value->SetModel(nullptr);
+	}
+	CharacterViewModels.Reset();
+	SET_DWORD_STAT(STAT_RsCharacterViewModels, 0);
+	
+	Super::Deinitialize();
+}
+
+URsCharacterViewModel* URsUIManagerSubsystem::FindOrCreateCharacterViewModel(ARsCharacterBase* Character)
+{
+	if (Character == nullptr)
+	{
+		return nullptr;
+	}
+
+	TObjectPtr<URsCharacterViewModel>& ViewModel = CharacterViewModels.FindOrAdd(Character);
+	if (ViewModel == nullptr)
+	{
+		ViewModel = NewObject<URsCharacterViewModel>(this);
+		ViewModel->SetModel(Character);
+		Character->OnEndPlay.AddUniqueDynamic(this, &ThisClass::HandleCharacterEndPlay);
+		INC_DWORD_STAT(STAT_RsCharacterViewModels);
+	}
+	return ViewModel;
+}
+
+void URsUIManagerSubsystem::ReleaseCharacterViewModel(ARsCharacterBase* Character)
+{
+	TObjectPtr<URsCharacterViewModel> ViewModel;
+	if (CharacterViewModels.RemoveAndCopyValue(Character, ViewModel))
+	{
+		Character->OnEndPlay.RemoveDynamic(this, &ThisClass::HandleCharacterEndPlay);
+		// Widgets may still hold the view model for a frame, so it must not keep listening to a character that is gone.
+		ViewModel->SetModel(nullptr);
+		DEC_DWORD_STAT(STAT_RsCharacterViewModels);
+	}
+}
+
+void URsUIManagerSubsystem::HandlePrewarmPartyMember(URsPartyComponent* PartyComponent, ARsPlayerCharacter* Member)
+{
+	// Every game instance hears every party, e.g. in multi-client PIE.
+	if (PartyComponent->GetWorld() && PartyComponent->GetWorld()->GetGameInstance() == GetGameInstance())
+	{
+		FindOrCreateCharacterViewModel(Member);
+	}
+}
+
+void URsUIManagerSubsystem::HandleCharacterEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseCharacterViewModel(Cast<ARsCharacterBase>(Actor));
+}
@@ -0,0 +1,46 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameUIManagerSubsystem.h"
+#include "RsUIManagerSubsystem.generated.h"
+
+class ARsCharacterBase;
+class ARsPlayerCharacter;
+class URsCharacterViewModel;
+class URsPartyComponent;
+
+/**
+ * Owns one character view model tree per character.
+ * HUDs, party slots and health bars that bind to the same character share its tree instead of creating their own.
+ * A tree is unbound and dropped when its character ends play.
+ */
+UCLASS()
+class RSUI_API URsUIManagerSubsystem : public UGameUIManagerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URsUIManagerSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Returns the cached view model of the character, creating it on first use.
+	URsCharacterViewModel* FindOrCreateCharacterViewModel(ARsCharacterBase* Character);
+
+	// Unbinds the character's view model from its attributes and drops it from the cache.
+	void ReleaseCharacterViewModel(ARsCharacterBase* Character);
+
+	int32 GetNumCharacterViewModels() const { return CharacterViewModels.Num(); }
+
+private:
+	void HandlePrewarmPartyMember(URsPartyComponent* PartyComponent, ARsPlayerCharacter* Member);
+
+	UFUNCTION()
+	void HandleCharacterEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	UPROPERTY(Transient)
+	TMap<TWeakObjectPtr<ARsCharacterBase>, TObjectPtr<URsCharacterViewModel>> CharacterViewModels;
+};
@@ -3,6 +3,7 @@
 
 #include "RsAbilityViewModel.h"
 
+#include "AbilitySystemComponent.h"
 #include "Rs/AbilitySystem/Abilities/RsGameplayAbility.h"
 
 URsAbilityViewModel* URsAbilityViewModel::CreateRsAbilityViewModel(URsGameplayAbility* Model)
@@ -14,7 +15,24 @@ URsAbilityViewModel* URsAbilityViewModel::CreateRsAbilityViewModel(URsGameplayAb
 
 void URsAbilityViewModel::Initialize()
 {
+	UnbindCooldownTag();
 	CachedModel = Cast<URsGameplayAbility>(GetOuter());
+
+	// Only tick while the cooldown tag is on the owner.
+	const FGameplayAbilityActorInfo* ActorInfo = CachedModel.IsValid() ? CachedModel->GetCurrentActorInfo() : nullptr;
+	if (ActorInfo && ActorInfo->AbilitySystemComponent.IsValid() && CachedModel->CooldownTag.IsValid())
+	{
+		BoundAbilitySystem = ActorInfo->AbilitySystemComponent.Get();
+		BoundCooldownTag = CachedModel->CooldownTag;
+		CooldownTagChangedHandle = BoundAbilitySystem->RegisterGameplayTagEvent(BoundCooldownTag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &ThisClass::HandleCooldownTagChanged);
+	}
+	StartCooldownTick();
+}
+
+void URsAbilityViewModel::BeginDestroy()
+{
+	UnbindCooldownTag();
+	Super::BeginDestroy();
 }
 
 float URsAbilityViewModel::GetCooldownDuration() const
@@ -59,7 +77,25 @@ bool URsAbilityViewModel::IsOnCooldown() const
 	return CooldownRemaining > 0.f;
 }
 
-void URsAbilityViewModel::Tick(float DeltaTime)
+void URsAbilityViewModel::StartCooldownTick()
+{
+	if (UCommonUITickerSubsystem* Ticker = UCommonUITickerSubsystem::Get(this))
+	{
+		CooldownTickHandle = Ticker->AddTicker(this, FCommonUITickDelegate::CreateUObject(this, &ThisClass::TickCooldown), CooldownTickHandle);
+	}
+	else
+	{
+		RefreshCooldown();
+	}
+}
+
+bool URsAbilityViewModel::TickCooldown(float DeltaTime)
+{
+	RefreshCooldown();
+	return IsOnCooldown();
+}
+
+void URsAbilityViewModel::RefreshCooldown()
 {
 	if (CachedModel.IsValid())
 	{
@@ -72,7 +108,18 @@ void URsAbilityViewModel::Tick(float DeltaTime)
 	}
 }
 
-TStatId URsAbilityViewModel::GetStatId() const
+void URsAbilityViewModel::HandleCooldownTagChanged(const FGameplayTag CooldownTag, int32 NewCount)
 {
-	RETURN_QUICK_DECLARE_CYCLE_STAT(URsAbilityViewModel, STATGROUP_Tickables);
-}
\ No newline at end of file
+	StartCooldownTick();
+}
+
+void URsAbilityViewModel::UnbindCooldownTag()
+{
+	if (UAbilitySystemComponent* AbilitySystemComponent = BoundAbilitySystem.Get())
+	{
+		AbilitySystemComponent->UnregisterGameplayTagEvent(CooldownTagChangedHandle, BoundCooldownTag, EGameplayTagEventType::NewOrRemoved);
+	}
+	CooldownTagChangedHandle.Reset();
+	BoundAbilitySystem.Reset();
+	BoundCooldownTag = FGameplayTag();
+}
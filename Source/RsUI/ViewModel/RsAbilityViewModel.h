@@ -3,17 +3,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CommonUITickerSubsystem.h"
+#include "GameplayTagContainer.h"
 #include "MVVMViewModelBase.h"
 #include "RsAbilityViewModel.generated.h"
 
 struct FActiveGameplayEffect;
+class UAbilitySystemComponent;
 class URsGameplayAbility;
 
 /**
  * 
  */
 UCLASS()
-class RS_API URsAbilityViewModel : public UMVVMViewModelBase, public FTickableGameObject
+class RSUI_API URsAbilityViewModel : public UMVVMViewModelBase
 {
 	GENERATED_BODY()
 	
@@ -23,6 +26,8 @@ public:
 
 	void Initialize();
 
+	virtual void BeginDestroy() override;
+
 	float GetCooldownDuration() const;
 	float GetCooldownRemaining() const;
 
@@ -35,12 +40,18 @@ public:
 	UFUNCTION(FieldNotify, BlueprintPure)
 	bool IsOnCooldown() const;
 
-	// FTickableGameObject
-	// NOTE: Ability class can't tick by default, but I want to display ability's info updated every frame.
-	virtual void Tick(float DeltaTime) override;
-	virtual TStatId GetStatId() const override;
-	
 private:
+	// Ability class can't tick by default, so the shared UI ticker updates the cooldown every frame while it runs.
+	void StartCooldownTick();
+	bool TickCooldown(float DeltaTime);
+	void RefreshCooldown();
+	void HandleCooldownTagChanged(const FGameplayTag CooldownTag, int32 NewCount);
+	void UnbindCooldownTag();
+	FCommonUITickHandle CooldownTickHandle;
+	FDelegateHandle CooldownTagChangedHandle;
+	TWeakObjectPtr<UAbilitySystemComponent> BoundAbilitySystem;
+	FGameplayTag BoundCooldownTag;
+
 	UPROPERTY(FieldNotify, BlueprintReadWrite, Getter, Setter, meta=(AllowPrivateAccess))
 	float CooldownDuration;
 	
@@ -0,0 +1,59 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsCharacterViewModel.h"
+
+#include "RsHealthSetViewModel.h"
+#include "RsStaggerSetViewModel.h"
+#include "Kismet/GameplayStatics.h"
+#include "Rs/Character/RsCharacterBase.h"
+#include "RsUI/Subsystem/RsUIManagerSubsystem.h"
+
+URsCharacterViewModel* URsCharacterViewModel::CreateRsCharacterViewModel(ARsCharacterBase* Model)
+{
+	if (Model == nullptr)
+	{
+		return nullptr;
+	}
+	
+	// Every binding to the same character shares one cached tree.
+	if (URsUIManagerSubsystem* UIManager = URsUIManagerSubsystem::Get(Model))
+	{
+		return UIManager->FindOrCreateCharacterViewModel(Model);
+	}
+	
+	URsCharacterViewModel* ViewModel = NewObject<URsCharacterViewModel>(Model);
+	ViewModel->SetModel(Model);
+	return ViewModel;
+}
+
+void URsCharacterViewModel::SetModel(ARsCharacterBase* NewModel)
+{
+	BoundModel = NewModel;
+	
+	FString DisplayName = NewModel ? UKismetSystemLibrary::GetDisplayName(NewModel) : FString();
+	SetCharacterName(FText::FromString(DisplayName));
+
+	// Children are owned by this view model, so they can outlive the model they were created for.
+	if (HealthSetViewModel == nullptr)
+	{
+		HealthSetViewModel = NewObject<URsHealthSetViewModel>(this);
+	}
+	HealthSetViewModel->SetModel(NewModel);
+	
+	if (StaggerSetViewModel == nullptr)
+	{
+		StaggerSetViewModel = NewObject<URsStaggerSetViewModel>(this);
+	}
+	StaggerSetViewModel->SetModel(NewModel);
+}
+
+FText URsCharacterViewModel::GetCharacterName() const
+{
+	return CharacterName;
+}
+
+void URsCharacterViewModel::SetCharacterName(FText NewCharacterName)
+{
+	UE_MVVM_SET_PROPERTY_VALUE(CharacterName, NewCharacterName);
+}
@@ -13,15 +13,18 @@ class ARsCharacterBase;
  * 
  */
 UCLASS()
-class RS_API URsCharacterViewModel : public UMVVMViewModelBase
+class RSUI_API URsCharacterViewModel : public UMVVMViewModelBase
 {
 	GENERATED_BODY()
 
 public:
+	// Returns the character's cached view model. Only creates a new one when there is no UI manager, e.g. on dedicated servers.
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	static URsCharacterViewModel* CreateRsCharacterViewModel(ARsCharacterBase* Model);
 
-	void Initialize();
+	// Points this view model and its children at another character. Pooled widgets reuse one view model tree this way.
+	void SetModel(ARsCharacterBase* NewModel);
+	ARsCharacterBase* GetModel() const { return BoundModel.Get(); }
 
 	FText GetCharacterName() const;
 	void SetCharacterName(FText NewCharacterName);
@@ -35,4 +38,6 @@ private:
 
 	UPROPERTY(FieldNotify, BlueprintReadWrite, meta=(AllowPrivateAccess))
 	TObjectPtr<URsStaggerSetViewModel> StaggerSetViewModel;
+
+	TWeakObjectPtr<ARsCharacterBase> BoundModel;
 };
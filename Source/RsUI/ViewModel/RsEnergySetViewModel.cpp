@@ -0,0 +1,131 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsEnergySetViewModel.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Rs/AbilitySystem/Attributes/RsEnergySet.h"
+#include "Rs/Character/RsCharacterBase.h"
+#include "RsUI/Subsystem/RsAttributeUpdateSubsystem.h"
+
+URsEnergySetViewModel* URsEnergySetViewModel::CreateEnergySetViewModel(AActor* Model)
+{
+	URsEnergySetViewModel* ViewModel = NewObject<URsEnergySetViewModel>(Model);
+	ViewModel->SetModel(Model);
+	return ViewModel;
+}
+
+void URsEnergySetViewModel::SetModel(AActor* NewModel)
+{
+	if (ARsCharacterBase* OldCharacter = Cast<ARsCharacterBase>(BoundModel.Get()))
+	{
+		OldCharacter->OnAbilitySystemInitialized.RemoveAll(this);
+	}
+	BoundModel = NewModel;
+	BoundAbilitySystem = nullptr;
+	
+	// Stay alive across party switches by following the model to its new ability system.
+	if (ARsCharacterBase* Character = Cast<ARsCharacterBase>(NewModel))
+	{
+		Character->OnAbilitySystemInitialized.AddUObject(this, &ThisClass::BindToAbilitySystem);
+	}
+	BindToAbilitySystem();
+}
+
+void URsEnergySetViewModel::BindToAbilitySystem()
+{
+	const AActor* Model = BoundModel.Get();
+	UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Model);
+	if (AbilitySystemComponent != BoundAbilitySystem || AbilitySystemComponent == nullptr)
+	{
+		// Changes are collected and delivered once per frame, instead of being broadcast inside effect execution.
+		if (URsAttributeUpdateSubsystem* AttributeUpdateSubsystem = URsAttributeUpdateSubsystem::Get(this))
+		{
+			AttributeUpdateSubsystem->UnregisterListener(ListenerHandle, this);
+			const FGameplayAttribute Attributes[] = {
+				URsEnergySet::GetMaxEnergyAttribute(),
+				URsEnergySet::GetCurrentEnergyAttribute(),
+				URsEnergySet::GetEnergyRegenAttribute() };
+			ListenerHandle = AttributeUpdateSubsystem->RegisterListener(this, AbilitySystemComponent, Model, Attributes, FRsAttributeValueDelegate::CreateUObject(this, &ThisClass::HandleAttributeChanged));
+		}
+		BoundAbilitySystem = AbilitySystemComponent;
+	}
+	RefreshFromModel();
+}
+
+void URsEnergySetViewModel::RefreshFromModel()
+{
+	const AActor* Model = BoundModel.Get();
+	if (const UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Model))
+	{
+		bool bFound;
+		SetMaxEnergy(AbilitySystemComponent->GetGameplayAttributeValue(URsEnergySet::GetMaxEnergyAttribute(), bFound));
+		SetCurrentEnergy(AbilitySystemComponent->GetGameplayAttributeValue(URsEnergySet::GetCurrentEnergyAttribute(), bFound));
+		SetEnergyRegen(AbilitySystemComponent->GetGameplayAttributeValue(URsEnergySet::GetEnergyRegenAttribute(), bFound));
+	}
+}
+
+float URsEnergySetViewModel::GetCurrentEnergy() const
+{
+	return CurrentEnergy;
+}
+
+float URsEnergySetViewModel::GetMaxEnergy() const
+{
+	return MaxEnergy;
+}
+
+float URsEnergySetViewModel::GetEnergyRegen() const
+{
+	return EnergyRegen;
+}
+
+void URsEnergySetViewModel::SetCurrentEnergy(float NewCurrentEnergy)
+{
+	if (UE_MVVM_SET_PROPERTY_VALUE(CurrentEnergy, NewCurrentEnergy))
+	{
+		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetEnergyPercent);
+	}
+}
+
+void URsEnergySetViewModel::SetMaxEnergy(float NewMaxEnergy)
+{
+	if (UE_MVVM_SET_PROPERTY_VALUE(MaxEnergy, NewMaxEnergy))
+	{
+		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetEnergyPercent);
+	}
+}
+
+void URsEnergySetViewModel::SetEnergyRegen(float NewEnergyRegen)
+{
+	UE_MVVM_SET_PROPERTY_VALUE(EnergyRegen, NewEnergyRegen);
+}
+
+float URsEnergySetViewModel::GetEnergyPercent() const
+{
+	if (MaxEnergy != 0)
+	{
+		return CurrentEnergy / MaxEnergy;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+void URsEnergySetViewModel::HandleAttributeChanged(const FGameplayAttribute& Attribute, float NewValue)
+{
+	if (Attribute == URsEnergySet::GetMaxEnergyAttribute())
+	{
+		SetMaxEnergy(NewValue);
+	}
+	else if (Attribute == URsEnergySet::GetCurrentEnergyAttribute())
+	{
+		SetCurrentEnergy(NewValue);
+	}
+	else if (Attribute == URsEnergySet::GetEnergyRegenAttribute())
+	{
+		SetEnergyRegen(NewValue);
+	}
+}
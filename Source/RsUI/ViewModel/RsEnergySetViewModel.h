@@ -6,12 +6,14 @@
 #include "MVVMViewModelBase.h"
 #include "RsEnergySetViewModel.generated.h"
 
-struct FOnAttributeChangeData;
+class UAbilitySystemComponent;
+struct FGameplayAttribute;
+
 /**
  * 
  */
 UCLASS()
-class RS_API URsEnergySetViewModel : public UMVVMViewModelBase
+class RSUI_API URsEnergySetViewModel : public UMVVMViewModelBase
 {
 	GENERATED_BODY()
 
@@ -19,7 +21,11 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	static URsEnergySetViewModel* CreateEnergySetViewModel(AActor* Model);
 
-	void Initialize();
+	// Points this view model at another actor. Pooled widgets reuse one view model this way.
+	void SetModel(AActor* NewModel);
+
+	// Reads every attribute from the model's ability system.
+	void RefreshFromModel();
 
 	float GetCurrentEnergy() const;
 	float GetMaxEnergy() const;
@@ -42,7 +48,13 @@ private:
 	UPROPERTY(FieldNotify, BlueprintReadWrite, Getter, Setter, meta=(AllowPrivateAccess))
 	float EnergyRegen;
 
-	void MaxEnergyChanged(const FOnAttributeChangeData& Data);
-	void CurrentEnergyChanged(const FOnAttributeChangeData& Data);
-	void EnergyRegenChanged(const FOnAttributeChangeData& Data);
+	TWeakObjectPtr<AActor> BoundModel;
+
+	// Ability system the attribute listener is registered to.
+	void BindToAbilitySystem();
+	TWeakObjectPtr<UAbilitySystemComponent> BoundAbilitySystem;
+	int32 ListenerHandle = INDEX_NONE;
+
+	// Called once per frame at most, with the latest value of each changed attribute.
+	void HandleAttributeChanged(const FGameplayAttribute& Attribute, float NewValue);
 };
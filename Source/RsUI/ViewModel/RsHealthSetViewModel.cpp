@@ -0,0 +1,131 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsHealthSetViewModel.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Rs/AbilitySystem/Attributes/RsHealthSet.h"
+#include "Rs/Character/RsCharacterBase.h"
+#include "RsUI/Subsystem/RsAttributeUpdateSubsystem.h"
+
+URsHealthSetViewModel* URsHealthSetViewModel::CreateHealthSetViewModel(AActor* Model)
+{
+	URsHealthSetViewModel* ViewModel = NewObject<URsHealthSetViewModel>(Model);
+	ViewModel->SetModel(Model);
+	return ViewModel;
+}
+
+void URsHealthSetViewModel::SetModel(AActor* NewModel)
+{
+	if (ARsCharacterBase* OldCharacter = Cast<ARsCharacterBase>(BoundModel.Get()))
+	{
+		OldCharacter->OnAbilitySystemInitialized.RemoveAll(this);
+	}
+	BoundModel = NewModel;
+	BoundAbilitySystem = nullptr;
+	
+	// Stay alive across party switches by following the model to its new ability system.
+	if (ARsCharacterBase* Character = Cast<ARsCharacterBase>(NewModel))
+	{
+		Character->OnAbilitySystemInitialized.AddUObject(this, &ThisClass::BindToAbilitySystem);
+	}
+	BindToAbilitySystem();
+}
+
+void URsHealthSetViewModel::BindToAbilitySystem()
+{
+	const AActor* Model = BoundModel.Get();
+	UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Model);
+	if (AbilitySystemComponent != BoundAbilitySystem || AbilitySystemComponent == nullptr)
+	{
+		// Changes are collected and delivered once per frame, instead of being broadcast inside effect execution.
+		if (URsAttributeUpdateSubsystem* AttributeUpdateSubsystem = URsAttributeUpdateSubsystem::Get(this))
+		{
+			AttributeUpdateSubsystem->UnregisterListener(ListenerHandle, this);
+			const FGameplayAttribute Attributes[] = {
+				URsHealthSet::GetMaxHealthAttribute(),
+				URsHealthSet::GetCurrentHealthAttribute(),
+				URsHealthSet::GetHealthRegenAttribute() };
+			ListenerHandle = AttributeUpdateSubsystem->RegisterListener(this, AbilitySystemComponent, Model, Attributes, FRsAttributeValueDelegate::CreateUObject(this, &ThisClass::HandleAttributeChanged));
+		}
+		BoundAbilitySystem = AbilitySystemComponent;
+	}
+	RefreshFromModel();
+}
+
+void URsHealthSetViewModel::RefreshFromModel()
+{
+	const AActor* Model = BoundModel.Get();
+	if (const UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Model))
+	{
+		bool bFound;
+		SetMaxHealth(AbilitySystemComponent->GetGameplayAttributeValue(URsHealthSet::GetMaxHealthAttribute(), bFound));
+		SetCurrentHealth(AbilitySystemComponent->GetGameplayAttributeValue(URsHealthSet::GetCurrentHealthAttribute(), bFound));
+		SetHealthRegen(AbilitySystemComponent->GetGameplayAttributeValue(URsHealthSet::GetHealthRegenAttribute(), bFound));
+	}
+}
+
+float URsHealthSetViewModel::GetCurrentHealth() const
+{
+	return CurrentHealth;
+}
+
+float URsHealthSetViewModel::GetMaxHealth() const
+{
+	return MaxHealth;
+}
+
+float URsHealthSetViewModel::GetHealthRegen() const
+{
+	return HealthRegen;
+}
+
+void URsHealthSetViewModel::SetCurrentHealth(float NewCurrentHealth)
+{
+	if (UE_MVVM_SET_PROPERTY_VALUE(CurrentHealth, NewCurrentHealth))
+	{
+		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetHealthPercent);
+	}
+}
+
+void URsHealthSetViewModel::SetMaxHealth(float NewMaxHealth)
+{
+	if (UE_MVVM_SET_PROPERTY_VALUE(MaxHealth, NewMaxHealth))
+	{
+		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetHealthPercent);
+	}
+}
+
+void URsHealthSetViewModel::SetHealthRegen(float NewHealthRegen)
+{
+	UE_MVVM_SET_PROPERTY_VALUE(HealthRegen, NewHealthRegen);
+}
+
+float URsHealthSetViewModel::GetHealthPercent() const
+{
+	if (MaxHealth != 0)
+	{
+		return CurrentHealth / MaxHealth;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+void URsHealthSetViewModel::HandleAttributeChanged(const FGameplayAttribute& Attribute, float NewValue)
+{
+	if (Attribute == URsHealthSet::GetMaxHealthAttribute())
+	{
+		SetMaxHealth(NewValue);
+	}
+	else if (Attribute == URsHealthSet::GetCurrentHealthAttribute())
+	{
+		SetCurrentHealth(NewValue);
+	}
+	else if (Attribute == URsHealthSet::GetHealthRegenAttribute())
+	{
+		SetHealthRegen(NewValue);
+	}
+}
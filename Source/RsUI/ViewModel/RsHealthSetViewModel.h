@@ -6,13 +6,14 @@
 #include "MVVMViewModelBase.h"
 #include "RsHealthSetViewModel.generated.h"
 
-struct FOnAttributeChangeData;
+class UAbilitySystemComponent;
+struct FGameplayAttribute;
 
 /**
  * 
  */
 UCLASS()
-class RS_API URsHealthSetViewModel : public UMVVMViewModelBase
+class RSUI_API URsHealthSetViewModel : public UMVVMViewModelBase
 {
 	GENERATED_BODY()
 
@@ -20,7 +21,11 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	static URsHealthSetViewModel* CreateHealthSetViewModel(AActor* Model);
 
-	void Initialize();
+	// Points this view model at another actor. Pooled widgets reuse one view model this way.
+	void SetModel(AActor* NewModel);
+
+	// Reads every attribute from the model's ability system.
+	void RefreshFromModel();
 
 	float GetCurrentHealth() const;
 	float GetMaxHealth() const;
@@ -43,7 +48,13 @@ private:
 	UPROPERTY(FieldNotify, BlueprintReadWrite, Getter, Setter, meta=(AllowPrivateAccess))
 	float HealthRegen;
 
-	void MaxHealthChanged(const FOnAttributeChangeData& Data);
-	void CurrentHealthChanged(const FOnAttributeChangeData& Data);
-	void HealthRegenChanged(const FOnAttributeChangeData& Data);
+	TWeakObjectPtr<AActor> BoundModel;
+
+	// Ability system the attribute listener is registered to.
+	void BindToAbilitySystem();
+	TWeakObjectPtr<UAbilitySystemComponent> BoundAbilitySystem;
+	int32 ListenerHandle = INDEX_NONE;
+
+	// Called once per frame at most, with the latest value of each changed attribute.
+	void HandleAttributeChanged(const FGameplayAttribute& Attribute, float NewValue);
 };
@@ -0,0 +1,131 @@
+﻿// Copyright 2024 Team BH.
+
+
+#include "RsStaggerSetViewModel.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Rs/AbilitySystem/Attributes/RsStaggerSet.h"
+#include "Rs/Character/RsCharacterBase.h"
+#include "RsUI/Subsystem/RsAttributeUpdateSubsystem.h"
+
+URsStaggerSetViewModel* URsStaggerSetViewModel::CreateStaggerSetViewModel(AActor* Model)
+{
+	URsStaggerSetViewModel* ViewModel = NewObject<URsStaggerSetViewModel>(Model);
+	ViewModel->SetModel(Model);
+	return ViewModel;
+}
+
+void URsStaggerSetViewModel::SetModel(AActor* NewModel)
+{
+	if (ARsCharacterBase* OldCharacter = Cast<ARsCharacterBase>(BoundModel.Get()))
+	{
+		OldCharacter->OnAbilitySystemInitialized.RemoveAll(this);
+	}
+	BoundModel = NewModel;
+	BoundAbilitySystem = nullptr;
+	
+	// Stay alive across party switches by following the model to its new ability system.
+	if (ARsCharacterBase* Character = Cast<ARsCharacterBase>(NewModel))
+	{
+		Character->OnAbilitySystemInitialized.AddUObject(this, &ThisClass::BindToAbilitySystem);
+	}
+	BindToAbilitySystem();
+}
+
+void URsStaggerSetViewModel::BindToAbilitySystem()
+{
+	const AActor* Model = BoundModel.Get();
+	UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Model);
+	if (AbilitySystemComponent != BoundAbilitySystem || AbilitySystemComponent == nullptr)
+	{
+		// Changes are collected and delivered once per frame, instead of being broadcast inside effect execution.
+		if (URsAttributeUpdateSubsystem* AttributeUpdateSubsystem = URsAttributeUpdateSubsystem::Get(this))
+		{
+			AttributeUpdateSubsystem->UnregisterListener(ListenerHandle, this);
+			const FGameplayAttribute Attributes[] = {
+				URsStaggerSet::GetMaxStaggerAttribute(),
+				URsStaggerSet::GetCurrentStaggerAttribute(),
+				URsStaggerSet::GetStaggerRegenAttribute() };
+			ListenerHandle = AttributeUpdateSubsystem->RegisterListener(this, AbilitySystemComponent, Model, Attributes, FRsAttributeValueDelegate::CreateUObject(this, &ThisClass::HandleAttributeChanged));
+		}
+		BoundAbilitySystem = AbilitySystemComponent;
+	}
+	RefreshFromModel();
+}
+
+void URsStaggerSetViewModel::RefreshFromModel()
+{
+	const AActor* Model = BoundModel.Get();
+	if (const UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Model))
+	{
+		bool bFound;
+		SetMaxStagger(AbilitySystemComponent->GetGameplayAttributeValue(URsStaggerSet::GetMaxStaggerAttribute(), bFound));
+		SetCurrentStagger(AbilitySystemComponent->GetGameplayAttributeValue(URsStaggerSet::GetCurrentStaggerAttribute(), bFound));
+		SetStaggerRegen(AbilitySystemComponent->GetGameplayAttributeValue(URsStaggerSet::GetStaggerRegenAttribute(), bFound));
+	}
+}
+
+float URsStaggerSetViewModel::GetCurrentStagger() const
+{
+	return CurrentStagger;
+}
+
+float URsStaggerSetViewModel::GetMaxStagger() const
+{
+	return MaxStagger;
+}
+
+float URsStaggerSetViewModel::GetStaggerRegen() const
+{
+	return StaggerRegen;
+}
+
+void URsStaggerSetViewModel::SetCurrentStagger(float NewCurrentStagger)
+{
+	if (UE_MVVM_SET_PROPERTY_VALUE(CurrentStagger, NewCurrentStagger))
+	{
+		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetStaggerPercent);
+	}
+}
+
+void URsStaggerSetViewModel::SetMaxStagger(float NewMaxStagger)
+{
+	if (UE_MVVM_SET_PROPERTY_VALUE(MaxStagger, NewMaxStagger))
+	{
+		UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED(GetStaggerPercent);
+	}
+}
+
+void URsStaggerSetViewModel::SetStaggerRegen(float NewStaggerRegen)
+{
+	UE_MVVM_SET_PROPERTY_VALUE(StaggerRegen, NewStaggerRegen);
+}
+
+float URsStaggerSetViewModel::GetStaggerPercent() const
+{
+	if (MaxStagger != 0)
+	{
+		return CurrentStagger / MaxStagger;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+void URsStaggerSetViewModel::HandleAttributeChanged(const FGameplayAttribute& Attribute, float NewValue)
+{
+	if (Attribute == URsStaggerSet::GetMaxStaggerAttribute())
+	{
+		SetMaxStagger(NewValue);
+	}
+	else if (Attribute == URsStaggerSet::GetCurrentStaggerAttribute())
+	{
+		SetCurrentStagger(NewValue);
+	}
+	else if (Attribute == URsStaggerSet::GetStaggerRegenAttribute())
+	{
+		SetStaggerRegen(NewValue);
+	}
+}
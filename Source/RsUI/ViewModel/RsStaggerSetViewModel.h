@@ -6,13 +6,14 @@
 #include "MVVMViewModelBase.h"
 #include "RsStaggerSetViewModel.generated.h"
 
-struct FOnAttributeChangeData;
+class UAbilitySystemComponent;
+struct FGameplayAttribute;
 
 /**
  * 
  */
 UCLASS()
-class RS_API URsStaggerSetViewModel : public UMVVMViewModelBase
+class RSUI_API URsStaggerSetViewModel : public UMVVMViewModelBase
 {
 	GENERATED_BODY()
 
@@ -20,7 +21,11 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	static URsStaggerSetViewModel* CreateStaggerSetViewModel(AActor* Model);
 
-	void Initialize();
+	// Points this view model at another actor. Pooled widgets reuse one view model this way.
+	void SetModel(AActor* NewModel);
+
+	// Reads every attribute from the model's ability system.
+	void RefreshFromModel();
 
 	float GetCurrentStagger() const;
 	float GetMaxStagger() const;
@@ -43,7 +48,13 @@ private:
 	UPROPERTY(FieldNotify, BlueprintReadWrite, Getter, Setter, meta=(AllowPrivateAccess))
 	float StaggerRegen;
 
-	void MaxStaggerChanged(const FOnAttributeChangeData& Data);
-	void CurrentStaggerChanged(const FOnAttributeChangeData& Data);
-	void StaggerRegenChanged(const FOnAttributeChangeData& Data);
+	TWeakObjectPtr<AActor> BoundModel;
+
+	// Ability system the attribute listener is registered to.
+	void BindToAbilitySystem();
+	TWeakObjectPtr<UAbilitySystemComponent> BoundAbilitySystem;
+	int32 ListenerHandle = INDEX_NONE;
+
+	// Called once per frame at most, with the latest value of each changed attribute.
+	void HandleAttributeChanged(const FGameplayAttribute& Attribute, float NewValue);
 };
@@ -0,0 +1,22 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "RsDamageNumberWidget.generated.h"
+
+/**
+ * Floating damage number owned by URsDamageNumberSubsystem.
+ * Widgets are pooled, so one widget shows many numbers over its lifetime.
+ */
+UCLASS(Abstract)
+class RSUI_API URsDamageNumberWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	// Called each time the widget is taken from the pool. HitCount is the number of hits summed into Damage.
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnDamageNumberShown(float Damage, bool bCritical, int32 HitCount);
+};
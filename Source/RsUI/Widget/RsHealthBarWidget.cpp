@@ -0,0 +1,26 @@
+// Copyright 2024 Team BH.
+
+
+#include "RsHealthBarWidget.h"
+
+#include "MVVMSubsystem.h"
+#include "RsUI/ViewModel/RsCharacterViewModel.h"
+#include "View/MVVMView.h"
+
+void URsHealthBarWidget::SetViewModel(URsCharacterViewModel* NewViewModel)
+{
+	if (CharacterViewModel == NewViewModel)
+	{
+		return;
+	}
+	
+	CharacterViewModel = NewViewModel;
+	
+	// Feeds view model bindings set to manual creation. Released bars keep their last binding while collapsed.
+	UMVVMView* View = NewViewModel ? UMVVMSubsystem::GetViewFromUserWidget(this) : nullptr;
+	if (View)
+	{
+		View->SetViewModelByClass(NewViewModel);
+	}
+	OnViewModelAssigned(NewViewModel);
+}
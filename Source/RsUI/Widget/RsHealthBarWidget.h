@@ -0,0 +1,32 @@
+// Copyright 2024 Team BH.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "RsHealthBarWidget.generated.h"
+
+class URsCharacterViewModel;
+
+/**
+ * Enemy health bar owned by URsHealthBarSubsystem.
+ * Widgets are pooled, so the same widget is pointed at different enemies over its lifetime.
+ */
+UCLASS(Abstract)
+class RSUI_API URsHealthBarWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	void SetViewModel(URsCharacterViewModel* NewViewModel);
+	URsCharacterViewModel* GetViewModel() const { return CharacterViewModel; }
+
+protected:
+	// Called when the bar starts showing another character. Reset animations and transient state here.
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnViewModelAssigned(URsCharacterViewModel* NewViewModel);
+	
+private:
+	UPROPERTY(BlueprintReadOnly, meta=(AllowPrivateAccess))
+	TObjectPtr<URsCharacterViewModel> CharacterViewModel;
+};